@@ -0,0 +1,226 @@
+#ifndef ECSL_COMPACT_BIT_RECORD_HPP_
+#define ECSL_COMPACT_BIT_RECORD_HPP_
+
+/**
+ * @file BitRecord.hpp
+ * Declares utility class for bit-granular packed representation of a record
+ * of unsigned fields (portable replacement for C++ bitfields)
+ */
+
+/// STD
+#include <climits>
+#include <cstddef>
+#include <type_traits>
+/// ECSL
+#include <ecsl/bits/Masks.h>
+#include <ecsl/compact/detail/Storage.hpp>
+#include <ecsl/type_traits/IndexSequence.hpp>
+#include <ecsl/type_traits/MinimalInteger.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace detail {
+namespace compact {
+
+/**
+ * Compile-time layout of bit fields placed back-to-back starting
+ * from the least significant bit of the first word
+ */
+template<unsigned ... Widths>
+struct bit_layout
+{
+    static constexpr std::size_t COUNT = sizeof...(Widths);
+    static constexpr unsigned WIDTHS[] = {Widths...};
+
+    static constexpr std::size_t offset(std::size_t index) noexcept
+    {
+        std::size_t r_{0};
+        for (std::size_t i{0}; i < index && i < COUNT; ++i)
+        {
+            r_ += WIDTHS[i];
+        }
+        return r_;
+    }
+
+    static constexpr bool valid() noexcept
+    {
+        for (std::size_t i{0}; i < COUNT; ++i)
+        {
+            if (WIDTHS[i] == 0 || WIDTHS[i] > 64)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr std::size_t BITS = offset(COUNT);
+    static constexpr std::size_t BYTES = (BITS + (CHAR_BIT - 1)) / CHAR_BIT;
+};
+
+/**
+ * Minimal unsigned integer capable of holding BYTES bytes
+ */
+template<std::size_t BYTES>
+using bytes_integer_t = unsigned_minimal_integer_t<types::memory_t[BYTES]>;
+
+/**
+ * Mask of first COUNT bits of type T (COUNT may be equal to bit width of T)
+ */
+template<class T, std::size_t COUNT>
+constexpr T low_mask() noexcept
+{
+    return COUNT >= sizeof(T) * CHAR_BIT ?
+        static_cast<T>(~T(0)) :
+        static_cast<T>(ECSL_MASK_TYPED(COUNT % (sizeof(T) * CHAR_BIT), T));
+}
+
+} // namespace compact
+} // namespace detail
+
+/**
+ * @brief Bit-granular packed record of unsigned fields
+ * Fields are laid out back-to-back from the least significant bit of the
+ * first storage word. Records up to 64 bits are held in a single minimal
+ * unsigned integer, larger ones in an array of 64-bit words (a field may
+ * straddle two words). All accessors are constexpr and branch-free: the
+ * word index, shift and mask of every field are compile-time constants.
+ * @tparam Widths Bit widths of fields in range [1:64]
+ */
+template<unsigned ... Widths>
+class bit_record
+{
+    using layout_t = detail::compact::bit_layout<Widths...>;
+
+    static_assert(sizeof...(Widths) != 0, "Can't create bit_record without fields");
+    static_assert(layout_t::valid(), "bit_record field width must be in range [1:64]");
+
+  public:
+    using word_type = typename std::conditional<
+        layout_t::BYTES <= sizeof(unsigned long long),
+        detail::compact::bytes_integer_t<
+            (layout_t::BYTES <= sizeof(unsigned long long) ?
+                layout_t::BYTES : sizeof(unsigned long long))>,
+        unsigned long long
+    >::type;
+    using size_type = std::size_t;
+
+    static constexpr size_type WORD_BITS = sizeof(word_type) * CHAR_BIT;
+    static constexpr size_type WORDS = (layout_t::BITS + (WORD_BITS - 1)) / WORD_BITS;
+
+    /**
+     * @brief Minimal unsigned type capable of holding I'th field
+     */
+    template<std::size_t I>
+    using value_type = detail::compact::bytes_integer_t<
+        (layout_t::WIDTHS[I] + (CHAR_BIT - 1)) / CHAR_BIT>;
+
+    template<std::size_t I>
+    static constexpr size_type width() noexcept { return layout_t::WIDTHS[I]; }
+
+    template<std::size_t I>
+    static constexpr size_type offset() noexcept { return layout_t::offset(I); }
+
+    /**
+     * @brief Mask of I'th field in it's own (not shifted) position
+     */
+    template<std::size_t I>
+    static constexpr unsigned long long mask() noexcept
+    {
+        return detail::compact::low_mask<unsigned long long, width<I>()>();
+    }
+
+    static constexpr size_type size() noexcept { return sizeof...(Widths); }
+    static constexpr size_type bits() noexcept { return layout_t::BITS; }
+
+  private:
+    word_type m_words[WORDS];
+
+    template<std::size_t I>
+    static constexpr size_type word_() noexcept { return offset<I>() / WORD_BITS; }
+    template<std::size_t I>
+    static constexpr size_type shift_() noexcept { return offset<I>() % WORD_BITS; }
+    template<std::size_t I>
+    static constexpr bool straddles_() noexcept
+    {
+        return shift_<I>() + width<I>() > WORD_BITS;
+    }
+
+    template<std::size_t ... I, class ... Args>
+    constexpr void set_all_(index_sequence<I...>, Args ... args) noexcept
+    {
+        using expand_ = int[];
+        (void)expand_{0, (set<I>(args), 0)...};
+    }
+
+  public:
+    constexpr bit_record() noexcept : m_words{} {}
+
+    template<class ... Args, class = typename std::enable_if<
+        sizeof...(Args) == sizeof...(Widths) &&
+        detail::compact::all_of<std::is_integral<Args>...>::value
+    >::type>
+    constexpr explicit bit_record(Args ... args) noexcept : m_words{}
+    {
+        set_all_(make_index_sequence<0, sizeof...(Widths)>{}, args...);
+    }
+
+    template<std::size_t I>
+    constexpr value_type<I> get() const noexcept
+    {
+        static_assert(I < sizeof...(Widths), "bit_record field index out of range");
+        using ull_t = unsigned long long;
+        constexpr auto WORD_ = word_<I>();
+        constexpr auto SHIFT_ = shift_<I>();
+        ull_t r_ = static_cast<ull_t>(m_words[WORD_]) >> SHIFT_;
+        if constexpr (straddles_<I>())
+        {
+            r_ |= static_cast<ull_t>(m_words[WORD_ + 1]) << (WORD_BITS - SHIFT_);
+        }
+        return static_cast<value_type<I>>(r_ & mask<I>());
+    }
+
+    template<std::size_t I>
+    constexpr void set(unsigned long long value) noexcept
+    {
+        static_assert(I < sizeof...(Widths), "bit_record field index out of range");
+        constexpr auto WORD_ = word_<I>();
+        constexpr auto SHIFT_ = shift_<I>();
+        constexpr auto MASK_ = mask<I>();
+        value &= MASK_;
+        m_words[WORD_] = static_cast<word_type>(
+            (m_words[WORD_] & ~static_cast<word_type>(MASK_ << SHIFT_)) |
+            static_cast<word_type>(value << SHIFT_));
+        if constexpr (straddles_<I>())
+        {
+            constexpr auto HIGH_ = WORD_BITS - SHIFT_;
+            m_words[WORD_ + 1] = static_cast<word_type>(
+                (m_words[WORD_ + 1] & ~static_cast<word_type>(MASK_ >> HIGH_)) |
+                static_cast<word_type>(value >> HIGH_));
+        }
+    }
+
+    constexpr word_type* data() noexcept { return m_words; }
+    constexpr const word_type* data() const noexcept { return m_words; }
+
+    /* Comparison operators */
+
+    friend constexpr bool operator==(const bit_record& lhs, const bit_record& rhs) noexcept
+    {
+        for (size_type i{0}; i < WORDS; ++i)
+        {
+            if (lhs.m_words[i] != rhs.m_words[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    friend constexpr bool operator!=(const bit_record& lhs, const bit_record& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+} // namespace ecsl
+#endif /* ECSL_COMPACT_BIT_RECORD_HPP_ */
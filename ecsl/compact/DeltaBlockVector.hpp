@@ -0,0 +1,383 @@
+#ifndef ECSL_COMPACT_DELTA_BLOCK_VECTOR_HPP_
+#define ECSL_COMPACT_DELTA_BLOCK_VECTOR_HPP_
+
+/**
+ * @file DeltaBlockVector.hpp
+ * Declares read-only container of (sorted) integer sequence compressed with
+ * delta encoding, frame-of-reference and bit-packing with patched exceptions
+ *
+ * The sequence is split into blocks of 128 values. For each block:
+ *  1. deltas between neighbour values are computed (first delta is 0,
+ *     the first value is kept in block header);
+ *  2. minimal delta is subtracted from all deltas (frame of reference);
+ *  3. bit width b minimizing the block size is chosen, deltas are packed
+ *     into 128 * b bits and deltas wider than b bits become exceptions:
+ *     their high bits are stored aside (positions + LEB128 values) and
+ *     patched in during decoding.
+ * Blocks are independent so any block may be decoded without the others.
+ * See: M. Zukowski et al. "Super-Scalar RAM-CPU Cache Compression" (PFOR),
+ * D. Lemire, L. Boytsov "Decoding billions of integers per second through
+ * vectorization" https://arxiv.org/abs/1209.2137
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+/// ECSL
+#include <ecsl/compact/PackedVector.hpp>
+#include <ecsl/compact/Varint.hpp>
+#include <ecsl/platform/Simd.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace detail {
+namespace compact {
+
+template<class T>
+struct delta_block_header
+{
+    T m_front;
+    T m_min_delta;
+    std::uint64_t m_word;
+    std::uint32_t m_exception;
+    std::uint8_t m_bits;
+    std::uint8_t m_exception_count;
+};
+
+template<class T>
+constexpr unsigned bit_width(T value) noexcept
+{
+    unsigned r_{0};
+    while (value)
+    {
+        value >>= 1;
+        ++r_;
+    }
+    return r_;
+}
+
+#if defined(ECSL_SIMD_AVX2)
+
+/**
+ * Inclusive prefix sum of 4 32-bit lanes plus carry from previous lanes
+ */
+inline __m128i prefix_sum_epi32(__m128i v, __m128i& carry) noexcept
+{
+    v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+    v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+    v = _mm_add_epi32(v, carry);
+    carry = _mm_shuffle_epi32(v, 0xFF);
+    return v;
+}
+
+#endif /* ECSL_SIMD_AVX2 */
+
+/**
+ * Fused unpack of bits-wide deltas, frame-of-reference restoration
+ * and prefix sum: dst[i] = front + sum(delta[1..i] + min_delta)
+ */
+template<class T>
+inline void unpack_prefix_sum(const packed_word_t* words, std::size_t bits,
+    T front, T min_delta, T* dst, std::size_t count) noexcept
+{
+    std::size_t i{0};
+    T acc_ = front;
+#if defined(ECSL_SIMD_AVX2)
+    if constexpr (sizeof(T) == 4)
+    {
+        if (bits <= 25)
+        {
+            const __m128i min_ = _mm_set1_epi32(static_cast<int>(min_delta));
+            //? The first delta is 0 and must not get min_delta
+            __m128i carry_ = _mm_set1_epi32(static_cast<int>(front - min_delta));
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i d_ = packed_unpack8_epi32(words, bits, i * bits);
+                const __m128i lo_ = prefix_sum_epi32(
+                    _mm_add_epi32(_mm256_castsi256_si128(d_), min_), carry_);
+                const __m128i hi_ = prefix_sum_epi32(
+                    _mm_add_epi32(_mm256_extracti128_si256(d_, 1), min_), carry_);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), lo_);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), hi_);
+            }
+            if (i)
+            {
+                acc_ = dst[i - 1];
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        acc_ += static_cast<T>(packed_get(words, bits, i * bits)) + (i ? min_delta : T{0});
+        dst[i] = acc_;
+    }
+}
+
+} // namespace compact
+} // namespace detail
+
+/**
+ * @brief Read-only compressed sequence of unsigned integers
+ * Designed for sorted (non-decreasing) sequences like posting lists and
+ * timestamps: arbitrary sequences are stored correctly (deltas wrap around)
+ * but compress poorly. Decoding of block without exceptions is a single
+ * fused unpack and prefix sum pass (vectorized with AVX2 for 32-bit values).
+ * @tparam T std::uint32_t or std::uint64_t
+ */
+template<class T = std::uint32_t>
+class delta_block_vector
+{
+    static_assert(std::is_same<T, std::uint32_t>::value ||
+        std::is_same<T, std::uint64_t>::value,
+        "delta_block_vector supports only std::uint32_t and std::uint64_t");
+
+    using header_type = detail::compact::delta_block_header<T>;
+    using word_type = detail::compact::packed_word_t;
+
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+    static constexpr size_type BLOCK_SIZE = 128;
+
+    delta_block_vector() : m_words(2, 0), m_size{0} {}
+    delta_block_vector(const value_type* src, size_type count) :
+        delta_block_vector()
+    {
+        assign(src, count);
+    }
+
+    /**
+     * @brief Replaces content with count values from src
+     */
+    void assign(const value_type* src, size_type count)
+    {
+        m_headers.clear();
+        m_words.clear();
+        m_exceptions.clear();
+        m_headers.reserve((count + BLOCK_SIZE - 1) / BLOCK_SIZE);
+        for (size_type first_{0}; first_ < count; first_ += BLOCK_SIZE)
+        {
+            const auto n_ = count - first_ < BLOCK_SIZE ? count - first_ : BLOCK_SIZE;
+            encode_block_(src + first_, n_);
+        }
+        //? Padding words for branch-free unpacking: zero-width block
+        //? at the end still reads two words
+        m_words.resize(m_words.size() + 2, 0);
+        m_size = count;
+    }
+
+    inline size_type size() const noexcept { return m_size; }
+    inline bool empty() const noexcept { return m_size == 0; }
+    inline size_type block_count() const noexcept { return m_headers.size(); }
+
+    inline size_type block_size(size_type block) const noexcept
+    {
+        return block + 1 < m_headers.size() ? BLOCK_SIZE : m_size - block * BLOCK_SIZE;
+    }
+
+    /**
+     * @brief First value of block (available without decoding)
+     */
+    inline value_type block_front(size_type block) const noexcept
+    {
+        return m_headers[block].m_front;
+    }
+
+    /**
+     * @brief Size of compressed representation in bytes
+     */
+    inline size_type bytes() const noexcept
+    {
+        return m_headers.size() * sizeof(header_type) +
+            m_words.size() * sizeof(word_type) + m_exceptions.size();
+    }
+
+    /**
+     * @brief Decodes single block
+     * @param[out] dst Buffer of at least block_size(block) values
+     * @return Count of decoded values
+     */
+    size_type decode_block(size_type block, value_type* dst) const noexcept
+    {
+        const auto& h_ = m_headers[block];
+        const auto n_ = block_size(block);
+        const auto* words_ = m_words.data() + h_.m_word;
+        if (!h_.m_exception_count)
+        {
+            detail::compact::unpack_prefix_sum(
+                words_, h_.m_bits, h_.m_front, h_.m_min_delta, dst, n_);
+            return n_;
+        }
+        //? Exceptions change deltas so they are patched before prefix sum
+        value_type deltas_[BLOCK_SIZE];
+        detail::compact::packed_unpack(words_, h_.m_bits, 0, deltas_, n_);
+        const auto* positions_ = m_exceptions.data() + h_.m_exception;
+        const auto* values_ = positions_ + h_.m_exception_count;
+        const auto* end_ = m_exceptions.data() + m_exceptions.size();
+        for (size_type i{0}; i < h_.m_exception_count; ++i)
+        {
+            value_type high_{0};
+            values_ += varint::decode(values_, end_, high_);
+            deltas_[positions_[i]] |= high_ << h_.m_bits;
+        }
+        value_type acc_ = h_.m_front;
+        dst[0] = acc_;
+        for (size_type i{1}; i < n_; ++i)
+        {
+            acc_ += deltas_[i] + h_.m_min_delta;
+            dst[i] = acc_;
+        }
+        return n_;
+    }
+
+    /**
+     * @brief Decodes whole sequence
+     * @param[out] dst Buffer of at least size() values
+     */
+    void decode(value_type* dst) const noexcept
+    {
+        for (size_type b{0}; b < m_headers.size(); ++b)
+        {
+            dst += decode_block(b, dst);
+        }
+    }
+
+    /**
+     * @brief Random access (decodes containing block)
+     */
+    value_type get(size_type position) const noexcept
+    {
+        value_type block_[BLOCK_SIZE];
+        decode_block(position / BLOCK_SIZE, block_);
+        return block_[position % BLOCK_SIZE];
+    }
+
+    value_type operator[](size_type position) const noexcept
+    {
+        return get(position);
+    }
+
+    /**
+     * @brief Position of the first value not less than value
+     * (sequence must be sorted). Decodes at most one block.
+     */
+    size_type lower_bound(value_type value) const noexcept
+    {
+        //? Last block with front < value
+        size_type lo_{0}, hi_{m_headers.size()};
+        while (lo_ < hi_)
+        {
+            const auto mid_ = lo_ + (hi_ - lo_) / 2;
+            if (m_headers[mid_].m_front < value)
+            {
+                lo_ = mid_ + 1;
+            }
+            else
+            {
+                hi_ = mid_;
+            }
+        }
+        if (lo_ == 0)
+        {
+            return 0;
+        }
+        const auto block_ = lo_ - 1;
+        value_type values_[BLOCK_SIZE];
+        const auto n_ = decode_block(block_, values_);
+        size_type i{0};
+        while (i < n_ && values_[i] < value)
+        {
+            ++i;
+        }
+        return block_ * BLOCK_SIZE + i;
+    }
+
+  private:
+    void encode_block_(const value_type* src, size_type count)
+    {
+        using namespace detail::compact;
+        value_type deltas_[BLOCK_SIZE] = {};
+        value_type min_{0};
+        for (size_type i{1}; i < count; ++i)
+        {
+            deltas_[i] = src[i] - src[i - 1];
+            min_ = (i == 1 || deltas_[i] < min_) ? deltas_[i] : min_;
+        }
+        //? Histogram of bit widths of deltas over frame of reference
+        size_type widths_[sizeof(value_type) * CHAR_BIT + 1] = {};
+        for (size_type i{1}; i < count; ++i)
+        {
+            deltas_[i] -= min_;
+            ++widths_[bit_width(deltas_[i])];
+        }
+        //? Choose packed width minimizing packed size plus exceptions size
+        //? (exception costs 1 byte of position and LEB128 of high bits)
+        constexpr unsigned MAX_BITS_ = sizeof(value_type) * CHAR_BIT;
+        unsigned bits_{MAX_BITS_};
+        size_type best_ = BLOCK_SIZE * MAX_BITS_;
+        for (unsigned b{0}; b <= MAX_BITS_; ++b)
+        {
+            size_type cost_ = BLOCK_SIZE * b;
+            for (unsigned w{b + 1}; w <= MAX_BITS_; ++w)
+            {
+                cost_ += widths_[w] * (CHAR_BIT + CHAR_BIT * ((w - b + 6) / 7));
+            }
+            if (cost_ < best_)
+            {
+                best_ = cost_;
+                bits_ = b;
+            }
+        }
+        header_type h_{};
+        h_.m_front = src[0];
+        h_.m_min_delta = min_;
+        h_.m_bits = static_cast<std::uint8_t>(bits_);
+        h_.m_word = m_words.size();
+        h_.m_exception = static_cast<std::uint32_t>(m_exceptions.size());
+        if (bits_)
+        {   //? 128 * bits is always a whole number of words, one more word
+            //? is a padding for packed_set
+            m_words.resize(m_words.size() + BLOCK_SIZE * bits_ / PACKED_WORD_BITS + 1, 0);
+            const auto mask_ = packed_mask(bits_);
+            auto* words_ = m_words.data() + h_.m_word;
+            for (size_type i{0}; i < count; ++i)
+            {
+                packed_set(words_, bits_, i * bits_, deltas_[i] & mask_);
+            }
+            m_words.pop_back();
+        }
+        std::uint8_t exceptions_{0};
+        for (size_type i{1}; i < count; ++i)
+        {
+            if (bits_ < MAX_BITS_ && (deltas_[i] >> bits_))
+            {
+                m_exceptions.push_back(static_cast<types::memory_t>(i));
+                ++exceptions_;
+            }
+        }
+        for (size_type i{1}; i < count; ++i)
+        {
+            if (bits_ < MAX_BITS_ && (deltas_[i] >> bits_))
+            {
+                types::memory_t buffer_[varint::MAX_SIZE_64];
+                const auto n_ = varint::encode(
+                    static_cast<std::uint64_t>(deltas_[i] >> bits_), buffer_);
+                m_exceptions.insert(m_exceptions.end(), buffer_, buffer_ + n_);
+            }
+        }
+        h_.m_exception_count = exceptions_;
+        m_headers.push_back(h_);
+    }
+
+    std::vector<header_type> m_headers;
+    std::vector<word_type> m_words;
+    std::vector<types::memory_t> m_exceptions;
+    size_type m_size;
+};
+
+} // namespace ecsl
+#endif /* ECSL_COMPACT_DELTA_BLOCK_VECTOR_HPP_ */
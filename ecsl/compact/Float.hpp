@@ -0,0 +1,428 @@
+#ifndef ECSL_COMPACT_FLOAT_HPP_
+#define ECSL_COMPACT_FLOAT_HPP_
+
+/**
+ * @file Float.hpp
+ * Declares compact 16-bit floating-point types: IEEE 754 binary16 (half)
+ * and bfloat16 (upper half of binary32)
+ *
+ * Values are stored as 16-bit patterns and converted to/from float on access.
+ * Conversion from float rounds to nearest even, overflow goes to infinity,
+ * NaN stays (quiet) NaN, half subnormals are supported. Bulk conversion uses
+ * AVX-512F/F16C/NEON for half and AVX-512F/SSE2 for bfloat16 and gives the
+ * same bit patterns as the scalar code.
+ * Sources:
+ *  https://fgiesen.wordpress.com/2012/03/28/half-to-float-done-quic/
+ *  https://cloud.google.com/tpu/docs/bfloat16
+ */
+
+/// STD
+#include <cstdint>
+#include <cstring>
+/// ECSL
+#include <ecsl/compact/detail/Storage.hpp>
+#include <ecsl/platform/Simd.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace detail {
+namespace compact {
+
+inline std::uint32_t float_bits(float value) noexcept
+{
+    std::uint32_t r_;
+    std::memcpy(&r_, &value, sizeof(r_));
+    return r_;
+}
+
+inline float bits_float(std::uint32_t value) noexcept
+{
+    float r_;
+    std::memcpy(&r_, &value, sizeof(r_));
+    return r_;
+}
+
+inline std::uint16_t load_bits16(const types::memory_t* src) noexcept
+{
+    std::uint16_t r_;
+    std::memcpy(&r_, src, sizeof(r_));
+    return r_;
+}
+
+inline void store_bits16(types::memory_t* dst, std::uint16_t value) noexcept
+{
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+/**
+ * IEEE 754 binary16: 1 sign, 5 exponent, 10 mantissa bits
+ */
+struct half_format
+{
+    static std::uint16_t encode(float value) noexcept
+    {
+        constexpr std::uint32_t F32_INF = 0xFFu << 23;
+        //? Smallest float rounding to half infinity is 65520
+        constexpr std::uint32_t F16_OVERFLOW = 0x477FF000u;
+        //? Smallest normal half is 2^-14
+        constexpr std::uint32_t F16_NORMAL = 113u << 23;
+        //? Adding 0.5 aligns half subnormal mantissa with the float one,
+        //? so FPU does round to nearest even
+        constexpr std::uint32_t DENORM_MAGIC = ((127 - 15) + (23 - 10) + 1) << 23;
+
+        std::uint32_t f_ = float_bits(value);
+        const auto sign_ = static_cast<std::uint16_t>((f_ >> 16) & 0x8000u);
+        f_ &= 0x7FFFFFFFu;
+        std::uint32_t r_;
+        if (f_ > F32_INF)
+        {   //? Quiet NaN keeping upper payload bits (same as vcvtps2ph)
+            r_ = 0x7E00u | ((f_ >> 13) & 0x03FFu);
+        }
+        else if (f_ >= F16_OVERFLOW)
+        {
+            r_ = 0x7C00u;
+        }
+        else if (f_ < F16_NORMAL)
+        {
+            r_ = float_bits(bits_float(f_) + bits_float(DENORM_MAGIC)) - DENORM_MAGIC;
+        }
+        else
+        {
+            const std::uint32_t odd_ = (f_ >> 13) & 1u;
+            r_ = (f_ + ((15u - 127u) << 23) + 0x0FFFu + odd_) >> 13;
+        }
+        return static_cast<std::uint16_t>(r_ | sign_);
+    }
+
+    static float decode(std::uint16_t value) noexcept
+    {
+        constexpr std::uint32_t EXPONENT = 0x7C00u << 13;
+        constexpr std::uint32_t MAGIC = 113u << 23;
+
+        std::uint32_t r_ = (value & 0x7FFFu) << 13;
+        const std::uint32_t exp_ = r_ & EXPONENT;
+        r_ += (127u - 15u) << 23;
+        if (exp_ == EXPONENT)
+        {   //? Inf/NaN, NaN is quieted (same as vcvtph2ps)
+            r_ += (128u - 16u) << 23;
+            if (r_ & 0x007FFFFFu)
+            {
+                r_ |= 0x00400000u;
+            }
+        }
+        else if (!exp_)
+        {   //? Zero/subnormal: renormalize through FPU
+            r_ = float_bits(bits_float(r_ + (1u << 23)) - bits_float(MAGIC));
+        }
+        return bits_float(r_ | (static_cast<std::uint32_t>(value & 0x8000u) << 16));
+    }
+
+    static void encode(const float* src, types::memory_t* dst, std::size_t count) noexcept
+    {
+        std::size_t i{0};
+#if defined(ECSL_SIMD_AVX512F)
+        //? maskz forms: the plain ones trip -Wmaybe-uninitialized in GCC 12 headers
+        for (; i + 16 <= count; i += 16)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i), _mm512_maskz_cvtps_ph(
+                0xFFFF, _mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+        }
+#endif
+#if defined(ECSL_SIMD_F16C)
+        for (; i + 8 <= count; i += 8)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i),
+                _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+        }
+#elif defined(ECSL_SIMD_NEON) && defined(__aarch64__)
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1_u16(reinterpret_cast<std::uint16_t*>(dst + 2 * i),
+                vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            store_bits16(dst + 2 * i, encode(src[i]));
+        }
+    }
+
+    static void decode(const types::memory_t* src, float* dst, std::size_t count) noexcept
+    {
+        std::size_t i{0};
+#if defined(ECSL_SIMD_AVX512F)
+        for (; i + 16 <= count; i += 16)
+        {
+            _mm512_storeu_ps(dst + i, _mm512_maskz_cvtph_ps(0xFFFF,
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i))));
+        }
+#endif
+#if defined(ECSL_SIMD_F16C)
+        for (; i + 8 <= count; i += 8)
+        {
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i))));
+        }
+#elif defined(ECSL_SIMD_NEON) && defined(__aarch64__)
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(
+                vld1_u16(reinterpret_cast<const std::uint16_t*>(src + 2 * i)))));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            dst[i] = decode(load_bits16(src + 2 * i));
+        }
+    }
+};
+
+/**
+ * bfloat16: 1 sign, 8 exponent, 7 mantissa bits (truncated binary32)
+ */
+struct bfloat16_format
+{
+    static std::uint16_t encode(float value) noexcept
+    {
+        const std::uint32_t f_ = float_bits(value);
+        if ((f_ & 0x7FFFFFFFu) > 0x7F800000u)
+        {   //? Quiet NaN: rounding could carry it into infinity
+            return static_cast<std::uint16_t>((f_ >> 16) | 0x0040u);
+        }
+        return static_cast<std::uint16_t>((f_ + 0x7FFFu + ((f_ >> 16) & 1u)) >> 16);
+    }
+
+    static float decode(std::uint16_t value) noexcept
+    {
+        return bits_float(static_cast<std::uint32_t>(value) << 16);
+    }
+
+    static void encode(const float* src, types::memory_t* dst, std::size_t count) noexcept
+    {
+        std::size_t i{0};
+#if defined(ECSL_SIMD_AVX512F)
+        {
+            const __m512i one_ = _mm512_set1_epi32(1);
+            const __m512i bias_ = _mm512_set1_epi32(0x7FFF);
+            const __m512i abs_ = _mm512_set1_epi32(0x7FFFFFFF);
+            const __m512i inf_ = _mm512_set1_epi32(0x7F800000);
+            const __m512i quiet_ = _mm512_set1_epi32(0x0040);
+            //? maskz forms: the plain ones trip -Wmaybe-uninitialized in GCC 12 headers
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m512i f_ = _mm512_castps_si512(_mm512_loadu_ps(src + i));
+                const __m512i high_ = _mm512_maskz_srli_epi32(0xFFFF, f_, 16);
+                const __m512i odd_ = _mm512_and_si512(high_, one_);
+                __m512i r_ = _mm512_maskz_srli_epi32(0xFFFF,
+                    _mm512_add_epi32(_mm512_add_epi32(f_, bias_), odd_), 16);
+                const __mmask16 nan_ = _mm512_cmpgt_epu32_mask(
+                    _mm512_and_si512(f_, abs_), inf_);
+                r_ = _mm512_mask_or_epi32(r_, nan_, high_, quiet_);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i),
+                    _mm512_maskz_cvtepi32_epi16(0xFFFF, r_));
+            }
+        }
+#endif
+#if defined(ECSL_SIMD_SSE2)
+        {
+            const __m128i one_ = _mm_set1_epi32(1);
+            const __m128i bias_ = _mm_set1_epi32(0x7FFF);
+            const __m128i abs_ = _mm_set1_epi32(0x7FFFFFFF);
+            const __m128i inf_ = _mm_set1_epi32(0x7F800000);
+            const __m128i quiet_ = _mm_set1_epi32(0x0040);
+            //? Result is 16-bit unsigned, sign extension makes signed
+            //? saturating pack exact
+            const auto round_ = [&](__m128i f_) noexcept {
+                const __m128i high_ = _mm_srli_epi32(f_, 16);
+                const __m128i r_ = _mm_srli_epi32(_mm_add_epi32(
+                    _mm_add_epi32(f_, bias_), _mm_and_si128(high_, one_)), 16);
+                const __m128i nan_ = _mm_cmpgt_epi32(_mm_and_si128(f_, abs_), inf_);
+                const __m128i v_ = _mm_or_si128(_mm_andnot_si128(nan_, r_),
+                    _mm_and_si128(nan_, _mm_or_si128(high_, quiet_)));
+                return _mm_srai_epi32(_mm_slli_epi32(v_, 16), 16);
+            };
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i lo_ = round_(_mm_castps_si128(_mm_loadu_ps(src + i)));
+                const __m128i hi_ = round_(_mm_castps_si128(_mm_loadu_ps(src + i + 4)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i),
+                    _mm_packs_epi32(lo_, hi_));
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            store_bits16(dst + 2 * i, encode(src[i]));
+        }
+    }
+
+    static void decode(const types::memory_t* src, float* dst, std::size_t count) noexcept
+    {
+        std::size_t i{0};
+#if defined(ECSL_SIMD_AVX512F)
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m256i v_ = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i));
+            _mm512_storeu_si512(dst + i, _mm512_maskz_slli_epi32(0xFFFF,
+                _mm512_maskz_cvtepu16_epi32(0xFFFF, v_), 16));
+        }
+#endif
+#if defined(ECSL_SIMD_SSE2)
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i v_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+            const __m128i zero_ = _mm_setzero_si128();
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(zero_, v_));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_unpackhi_epi16(zero_, v_));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            dst[i] = decode(load_bits16(src + 2 * i));
+        }
+    }
+};
+
+} // namespace compact
+} // namespace detail
+
+/**
+ * @brief Compact (not-aligned) 16-bit floating-point value
+ * Arithmetic is done in float and the result is rounded back on store.
+ * @tparam Format detail::compact::half_format or bfloat16_format
+ */
+template<class Format>
+class compact_float
+{
+    detail::compact::storage<std::uint16_t> m_storage;
+
+  public:
+    using value_type    = float;
+    using bits_type     = std::uint16_t;
+    using size_type     = std::size_t;
+
+    compact_float() noexcept { m_storage.store(bits_type(0)); }
+    explicit compact_float(value_type value) noexcept { store(value); }
+
+    /**
+     * @brief Makes value from raw 16-bit pattern
+     */
+    static inline compact_float from_bits(bits_type value) noexcept
+    {
+        compact_float r_;
+        r_.m_storage.store(value);
+        return r_;
+    }
+
+    compact_float& operator=(value_type value) noexcept
+    {
+        store(value);
+        return *this;
+    }
+
+    inline void store(value_type value) noexcept
+    {
+        m_storage.store(Format::encode(value));
+    }
+
+    inline value_type load() const noexcept
+    {
+        return Format::decode(m_storage.load());
+    }
+
+    inline bits_type bits() const noexcept { return m_storage.load(); }
+
+    inline operator value_type() const noexcept { return load(); }
+
+    /**
+     * @brief Converts count floats from src into dst
+     */
+    static inline void encode(const value_type* src, compact_float* dst, size_type count) noexcept
+    {
+        static_assert(sizeof(compact_float) == sizeof(bits_type), "compact_float must be packed");
+        Format::encode(src, reinterpret_cast<types::memory_t*>(dst), count);
+    }
+
+    /**
+     * @brief Converts count values from src into floats in dst
+     */
+    static inline void decode(const compact_float* src, value_type* dst, size_type count) noexcept
+    {
+        Format::decode(reinterpret_cast<const types::memory_t*>(src), dst, count);
+    }
+
+    /* Arithmetic operators */
+
+    inline compact_float operator+() const noexcept { return *this; }
+    inline compact_float operator-() const noexcept
+    {
+        return from_bits(static_cast<bits_type>(bits() ^ 0x8000u));
+    }
+
+    inline compact_float& operator+=(value_type a) noexcept
+    {
+        store(load() + a);
+        return *this;
+    }
+    inline compact_float& operator-=(value_type a) noexcept
+    {
+        store(load() - a);
+        return *this;
+    }
+    inline compact_float& operator*=(value_type a) noexcept
+    {
+        store(load() * a);
+        return *this;
+    }
+    inline compact_float& operator/=(value_type a) noexcept
+    {
+        store(load() / a);
+        return *this;
+    }
+
+    /* Comparison operators (by value: -0 == +0, NaN != NaN) */
+
+    inline friend bool operator==(
+        const compact_float& lhs, const compact_float& rhs) noexcept
+    {
+        return lhs.load() == rhs.load();
+    }
+    inline friend bool operator!=(
+        const compact_float& lhs, const compact_float& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+    inline friend bool operator<(
+        const compact_float& lhs, const compact_float& rhs) noexcept
+    {
+        return lhs.load() < rhs.load();
+    }
+    inline friend bool operator>(
+        const compact_float& lhs, const compact_float& rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+    inline friend bool operator>=(
+        const compact_float& lhs, const compact_float& rhs) noexcept
+    {
+        return lhs.load() >= rhs.load();
+    }
+    inline friend bool operator<=(
+        const compact_float& lhs, const compact_float& rhs) noexcept
+    {
+        return lhs.load() <= rhs.load();
+    }
+};
+
+/**
+ * @brief IEEE 754 binary16: ~3.3 decimal digits, range 6e-8 .. 65504
+ */
+using compact_half = compact_float<detail::compact::half_format>;
+
+/**
+ * @brief bfloat16: ~2.4 decimal digits, float range
+ */
+using compact_bfloat16 = compact_float<detail::compact::bfloat16_format>;
+
+} // namespace ecsl
+#endif /* ECSL_COMPACT_FLOAT_HPP_ */
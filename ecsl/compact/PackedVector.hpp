@@ -0,0 +1,497 @@
+#ifndef ECSL_COMPACT_PACKED_VECTOR_HPP_
+#define ECSL_COMPACT_PACKED_VECTOR_HPP_
+
+/**
+ * @file PackedVector.hpp
+ * Declares container of unsigned integers each stored in fixed count of bits
+ * (bit-granular counterpart of compact_vector)
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+/// ECSL
+#include <ecsl/platform/Simd.hpp>
+#include <ecsl/type_traits/MinimalInteger.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace detail {
+namespace compact {
+
+using packed_word_t = std::uint64_t;
+
+constexpr std::size_t PACKED_WORD_BITS = sizeof(packed_word_t) * CHAR_BIT;
+
+constexpr packed_word_t packed_mask(std::size_t bits) noexcept
+{
+    return bits >= PACKED_WORD_BITS ?
+        ~packed_word_t{0} :
+        (packed_word_t{1} << bits) - 1;
+}
+
+/**
+ * Reads bits-wide value at bit position pos of word stream.
+ * Branch-free: always touches word after the one containing pos,
+ * so the stream must have one word of padding at the end.
+ */
+inline packed_word_t packed_get(
+    const packed_word_t* words, std::size_t bits, std::size_t pos) noexcept
+{
+    const auto word_ = pos / PACKED_WORD_BITS;
+    const auto shift_ = pos % PACKED_WORD_BITS;
+    //? (x << 1) << (63 - s) is x << (64 - s) that is defined for s == 0
+    return ((words[word_] >> shift_) |
+        ((words[word_ + 1] << 1) << (PACKED_WORD_BITS - 1 - shift_))) &
+        packed_mask(bits);
+}
+
+/**
+ * Writes bits-wide value at bit position pos of word stream.
+ * Same padding requirement as packed_get.
+ */
+inline void packed_set(
+    packed_word_t* words, std::size_t bits, std::size_t pos, packed_word_t value) noexcept
+{
+    const auto word_ = pos / PACKED_WORD_BITS;
+    const auto shift_ = pos % PACKED_WORD_BITS;
+    const auto high_ = PACKED_WORD_BITS - 1 - shift_;
+    const auto mask_ = packed_mask(bits);
+    value &= mask_;
+    words[word_] = (words[word_] & ~(mask_ << shift_)) | (value << shift_);
+    words[word_ + 1] = (words[word_ + 1] & ~((mask_ >> 1) >> high_)) |
+        ((value >> 1) >> high_);
+}
+
+#if defined(ECSL_SIMD_AVX2)
+
+/**
+ * Gathers 8 values of bits <= 25 starting at bit position pos
+ * (every value fits in a 32-bit window from it's first byte)
+ */
+inline __m256i packed_unpack8_epi32(
+    const packed_word_t* words, std::size_t bits, std::size_t pos) noexcept
+{
+    const auto* base_ = reinterpret_cast<const int*>(
+        reinterpret_cast<const types::memory_t*>(words) + pos / CHAR_BIT);
+    const auto b_ = static_cast<int>(bits);
+    const __m256i rel_ = _mm256_add_epi32(
+        _mm256_set1_epi32(static_cast<int>(pos % CHAR_BIT)),
+        _mm256_setr_epi32(0, b_, 2 * b_, 3 * b_, 4 * b_, 5 * b_, 6 * b_, 7 * b_));
+    const __m256i v_ = _mm256_i32gather_epi32(base_, _mm256_srli_epi32(rel_, 3), 1);
+    return _mm256_and_si256(
+        _mm256_srlv_epi32(v_, _mm256_and_si256(rel_, _mm256_set1_epi32(7))),
+        _mm256_set1_epi32(static_cast<int>(packed_mask(bits))));
+}
+
+/**
+ * Gathers 4 values of bits <= 57 starting at bit position pos
+ * (every value fits in a 64-bit window from it's first byte)
+ */
+inline __m256i packed_unpack4_epi64(
+    const packed_word_t* words, std::size_t bits, std::size_t pos) noexcept
+{
+    const auto* base_ = reinterpret_cast<const long long*>(
+        reinterpret_cast<const types::memory_t*>(words) + pos / CHAR_BIT);
+    const auto b_ = static_cast<long long>(bits);
+    const __m256i rel_ = _mm256_add_epi64(
+        _mm256_set1_epi64x(static_cast<long long>(pos % CHAR_BIT)),
+        _mm256_setr_epi64x(0, b_, 2 * b_, 3 * b_));
+    const __m256i v_ = _mm256_i64gather_epi64(base_, _mm256_srli_epi64(rel_, 3), 1);
+    return _mm256_and_si256(
+        _mm256_srlv_epi64(v_, _mm256_and_si256(rel_, _mm256_set1_epi64x(7))),
+        _mm256_set1_epi64x(static_cast<long long>(packed_mask(bits))));
+}
+
+#endif /* ECSL_SIMD_AVX2 */
+
+/**
+ * Unpacks count values of bits width starting from bit position pos
+ * into 32-bit integers (bits must be <= 32)
+ */
+inline void packed_unpack(const packed_word_t* words, std::size_t bits,
+    std::size_t pos, std::uint32_t* dst, std::size_t count) noexcept
+{
+    std::size_t i{0};
+#if defined(ECSL_SIMD_AVX2)
+    if (bits <= 25)
+    {
+        for (; i + 8 <= count; i += 8, pos += 8 * bits)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                packed_unpack8_epi32(words, bits, pos));
+        }
+    }
+    else
+    {
+        //? 0, 2, 4, 6 are the low halves of 64-bit lanes
+        const __m256i perm_ = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+        for (; i + 4 <= count; i += 4, pos += 4 * bits)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+                    packed_unpack4_epi64(words, bits, pos), perm_)));
+        }
+    }
+#endif
+    for (; i < count; ++i, pos += bits)
+    {
+        dst[i] = static_cast<std::uint32_t>(packed_get(words, bits, pos));
+    }
+}
+
+/**
+ * Unpacks count values of bits width starting from bit position pos
+ * into 64-bit integers
+ */
+inline void packed_unpack(const packed_word_t* words, std::size_t bits,
+    std::size_t pos, std::uint64_t* dst, std::size_t count) noexcept
+{
+    std::size_t i{0};
+#if defined(ECSL_SIMD_AVX2)
+    if (bits <= 57)
+    {
+        for (; i + 4 <= count; i += 4, pos += 4 * bits)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                packed_unpack4_epi64(words, bits, pos));
+        }
+    }
+#endif
+    for (; i < count; ++i, pos += bits)
+    {
+        dst[i] = packed_get(words, bits, pos);
+    }
+}
+
+} // namespace compact
+} // namespace detail
+
+/**
+ * @brief Dense vector of unsigned integers each stored in Bits bits
+ * Values are packed into a stream of 64-bit words starting from the least
+ * significant bit. Random access is O(1) and branch-free. Bulk unpack to
+ * 32/64-bit integers uses AVX2 gathers when enabled for the translation unit.
+ * @tparam Bits Count of bits per value in range [1:64]
+ */
+template<unsigned Bits>
+class packed_vector
+{
+    static_assert(Bits != 0 && Bits <= 64, "packed_vector Bits must be in range [1:64]");
+
+    using word_type = detail::compact::packed_word_t;
+    static constexpr std::size_t WORD_BITS = detail::compact::PACKED_WORD_BITS;
+
+  public:
+    using value_type    = unsigned_minimal_integer_t<
+        types::memory_t[(Bits + (CHAR_BIT - 1)) / CHAR_BIT]>;
+    using size_type     = std::size_t;
+
+    /**
+     * @brief Count of words needed to store count values (with padding word)
+     */
+    static constexpr size_type words_for(size_type count) noexcept
+    {
+        return (count * Bits + (WORD_BITS - 1)) / WORD_BITS + 1;
+    }
+
+    /**
+     * @brief Count of bytes of storage needed for count values
+     */
+    static constexpr size_type footprint(size_type count) noexcept
+    {
+        return words_for(count) * sizeof(word_type);
+    }
+
+    static constexpr size_type bits() noexcept { return Bits; }
+
+    /**
+     * Reference-like object for a single value
+     */
+    class reference
+    {
+        friend class packed_vector;
+
+        word_type* m_words;
+        size_type m_position;
+
+        reference(word_type* words, size_type position) noexcept :
+            m_words{words}, m_position{position}
+        {}
+
+      public:
+        inline reference& operator=(value_type value) noexcept
+        {
+            detail::compact::packed_set(m_words, Bits, m_position * Bits, value);
+            return *this;
+        }
+
+        inline reference& operator=(const reference& other) noexcept
+        {
+            return *this = static_cast<value_type>(other);
+        }
+
+        inline operator value_type() const noexcept
+        {
+            return static_cast<value_type>(
+                detail::compact::packed_get(m_words, Bits, m_position * Bits));
+        }
+    };
+
+    /**
+     * Random access iterator over stored values (yields values)
+     */
+    class const_iterator
+    {
+        friend class packed_vector;
+
+        const word_type* m_words;
+        size_type m_position;
+
+        const_iterator(const word_type* words, size_type position) noexcept :
+            m_words{words}, m_position{position}
+        {}
+
+      public:
+        using value_type        = typename packed_vector::value_type;
+        using pointer           = void;
+        using reference         = value_type;
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+
+        const_iterator() noexcept : m_words{nullptr}, m_position{0} {}
+
+        inline value_type operator*() const noexcept
+        {
+            return static_cast<value_type>(
+                detail::compact::packed_get(m_words, Bits, m_position * Bits));
+        }
+        inline value_type operator[](difference_type n) const noexcept
+        {
+            return *(*this + n);
+        }
+
+        inline const_iterator& operator++() noexcept { ++m_position; return *this; }
+        inline const_iterator operator++(int) noexcept
+        {
+            const_iterator old{*this};
+            ++(*this);
+            return old;
+        }
+        inline const_iterator& operator--() noexcept { --m_position; return *this; }
+        inline const_iterator operator--(int) noexcept
+        {
+            const_iterator old{*this};
+            --(*this);
+            return old;
+        }
+
+        inline const_iterator& operator+=(difference_type n) noexcept
+        {
+            m_position += n;
+            return *this;
+        }
+        inline const_iterator& operator-=(difference_type n) noexcept
+        {
+            m_position -= n;
+            return *this;
+        }
+        friend inline const_iterator operator+(const_iterator a, difference_type n) noexcept
+        {
+            return a += n;
+        }
+        friend inline const_iterator operator+(difference_type n, const_iterator a) noexcept
+        {
+            return a += n;
+        }
+        friend inline const_iterator operator-(const_iterator a, difference_type n) noexcept
+        {
+            return a -= n;
+        }
+        friend inline difference_type
+            operator-(const const_iterator& b, const const_iterator& a) noexcept
+        {
+            return static_cast<difference_type>(b.m_position) -
+                static_cast<difference_type>(a.m_position);
+        }
+
+        friend inline bool
+            operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {   //? This operation must not be defined for different containers
+            return lhs.m_position == rhs.m_position;
+        }
+        friend inline bool
+            operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend inline bool
+            operator<(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return lhs.m_position < rhs.m_position;
+        }
+        friend inline bool
+            operator>(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+        friend inline bool
+            operator<=(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+        friend inline bool
+            operator>=(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+    };
+
+    using iterator = const_iterator;
+
+    packed_vector() : m_words(1, 0), m_size{0} {}
+    explicit packed_vector(size_type count) :
+        m_words(words_for(count), 0), m_size{count}
+    {}
+
+    inline size_type size() const noexcept { return m_size; }
+    inline bool empty() const noexcept { return m_size == 0; }
+    inline size_type capacity() const noexcept
+    {
+        return (m_words.capacity() - 1) * WORD_BITS / Bits;
+    }
+
+    inline void reserve(size_type count) { m_words.reserve(words_for(count)); }
+
+    inline void resize(size_type count)
+    {
+        if (count < m_size)
+        {   //? Keep the bits past the end zeroed for comparison
+            for (size_type i{count}; i < m_size; ++i)
+            {
+                set(i, 0);
+            }
+        }
+        m_words.resize(words_for(count), 0);
+        m_size = count;
+    }
+
+    inline void clear() noexcept
+    {
+        m_words.assign(1, 0);
+        m_size = 0;
+    }
+
+    /**
+     * @brief Size of storage in bytes (footprint(size()))
+     */
+    inline size_type bytes() const noexcept { return m_words.size() * sizeof(word_type); }
+    inline const word_type* data() const noexcept { return m_words.data(); }
+
+    inline value_type get(size_type position) const noexcept
+    {
+        return static_cast<value_type>(
+            detail::compact::packed_get(m_words.data(), Bits, position * Bits));
+    }
+
+    inline void set(size_type position, value_type value) noexcept
+    {
+        detail::compact::packed_set(m_words.data(), Bits, position * Bits, value);
+    }
+
+    inline value_type operator[](size_type position) const noexcept
+    {
+        return get(position);
+    }
+    inline reference operator[](size_type position) noexcept
+    {
+        return {m_words.data(), position};
+    }
+
+    inline value_type at(size_type position) const
+    {
+        if (position < m_size)
+        {
+            return get(position);
+        }
+        throw std::out_of_range{"packed_vector range check failed"};
+    }
+
+    inline void push_back(value_type value)
+    {
+        resize(m_size + 1);
+        set(m_size - 1, value);
+    }
+
+    inline void pop_back() noexcept
+    {
+        set(m_size - 1, 0);
+        --m_size;
+    }
+
+    inline const_iterator begin() const noexcept { return {m_words.data(), 0}; }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline const_iterator end() const noexcept { return {m_words.data(), m_size}; }
+    inline const_iterator cend() const noexcept { return end(); }
+
+    /**
+     * @brief Bulk unpack of values [first, first + count) into dst
+     */
+    template<class U>
+    inline typename std::enable_if<
+        (std::is_same<U, std::uint32_t>::value && Bits <= 32) ||
+        std::is_same<U, std::uint64_t>::value
+    >::type unpack(U* dst, size_type count, size_type first = 0) const noexcept
+    {
+        detail::compact::packed_unpack(m_words.data(), Bits, first * Bits, dst, count);
+    }
+
+    /**
+     * @brief Bulk store of count values from src into [first, first + count)
+     * The range must be within the current size()
+     */
+    template<class U>
+    inline typename std::enable_if<std::is_unsigned<U>::value>::type
+        pack(const U* src, size_type count, size_type first = 0) noexcept
+    {
+        auto pos_ = first * Bits;
+        for (size_type i{0}; i < count; ++i, pos_ += Bits)
+        {
+            detail::compact::packed_set(m_words.data(), Bits, pos_, src[i]);
+        }
+    }
+
+    /**
+     * @brief Appends count values from src to the end of vector
+     */
+    template<class U>
+    inline typename std::enable_if<std::is_unsigned<U>::value>::type
+        append(const U* src, size_type count)
+    {
+        const auto first_ = m_size;
+        resize(m_size + count);
+        pack(src, count, first_);
+    }
+
+    inline friend bool operator==(
+        const packed_vector& lhs, const packed_vector& rhs) noexcept
+    {
+        return lhs.m_size == rhs.m_size && lhs.m_words == rhs.m_words;
+    }
+    inline friend bool operator!=(
+        const packed_vector& lhs, const packed_vector& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+  private:
+    std::vector<word_type> m_words;
+    size_type m_size;
+};
+
+} // namespace ecsl
+#endif /* ECSL_COMPACT_PACKED_VECTOR_HPP_ */
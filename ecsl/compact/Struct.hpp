@@ -0,0 +1,219 @@
+#ifndef ECSL_COMPACT_STRUCT_HPP_
+#define ECSL_COMPACT_STRUCT_HPP_
+
+/**
+ * @file Struct.hpp
+ * Declares utility class for compact (non-aligned, non-padded) representation
+ * of a record of trivially copyable fields
+ */
+
+/// STD
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+/// ECSL
+#include <ecsl/compact/detail/Storage.hpp>
+#include <ecsl/type_traits/IndexSequence.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+#include <ecsl/utility/UnalignedAccess.hpp>
+
+namespace ecsl {
+namespace detail {
+namespace compact {
+
+/**
+ * Compile-time layout of fields placed back-to-back without any padding
+ */
+template<class ... Fields>
+struct struct_layout
+{
+    static constexpr std::size_t COUNT = sizeof...(Fields);
+    static constexpr std::size_t SIZES[] = {sizeof(Fields)...};
+
+    static constexpr std::size_t offset(std::size_t index) noexcept
+    {
+        std::size_t r_{0};
+        for (std::size_t i{0}; i < index && i < COUNT; ++i)
+        {
+            r_ += SIZES[i];
+        }
+        return r_;
+    }
+
+    static constexpr std::size_t SIZE = offset(COUNT);
+};
+
+} // namespace compact
+} // namespace detail
+
+/**
+ * @brief Compact (not-aligned, not-padded) representation of a record
+ * Fields are laid out one after another in declaration order and each
+ * access is a single unaligned load or store of the field's bytes.
+ * Suitable for wire-format and on-disk records.
+ * Supports structured bindings (by value): auto [a, b] = record;
+ * @tparam Fields Trivially copyable types of record fields
+ */
+template<class ... Fields>
+class compact_struct
+{
+    using layout_t = detail::compact::struct_layout<Fields...>;
+
+    static_assert(sizeof...(Fields) != 0,
+        "Can't create compact_struct without fields");
+    static_assert(detail::compact::all_of<std::is_trivially_copyable<Fields>...>::value,
+        "All fields of compact_struct must be trivially copyable");
+
+    types::memory_t m_data[layout_t::SIZE];
+
+    template<std::size_t ... I, class ... Args>
+    inline void store_all_(index_sequence<I...>, Args&& ... args) noexcept
+    {
+        using expand_ = int[];
+        (void)expand_{0, (set<I>(std::forward<Args>(args)), 0)...};
+    }
+
+    template<std::size_t ... I>
+    inline bool equal_(index_sequence<I...>, const compact_struct& other) const noexcept
+    {
+        bool r_{true};
+        using expand_ = int[];
+        (void)expand_{0, (r_ = r_ && get<I>() == other.template get<I>(), 0)...};
+        return r_;
+    }
+
+  public:
+    template<std::size_t I>
+    using element_type = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+    using size_type = std::size_t;
+
+    /**
+     * @brief Byte offset of I'th field from the beginning of record
+     */
+    template<std::size_t I>
+    static constexpr size_type offset() noexcept
+    {
+        static_assert(I < sizeof...(Fields), "compact_struct field index out of range");
+        return layout_t::offset(I);
+    }
+
+    /**
+     * @brief Count of fields in record
+     */
+    static constexpr size_type size() noexcept { return sizeof...(Fields); }
+
+    /**
+     * @brief Size of record binary representation in bytes
+     */
+    static constexpr size_type bytes() noexcept { return layout_t::SIZE; }
+
+    compact_struct() noexcept : m_data{} {}
+
+    template<class ... Args, class = typename std::enable_if<
+        sizeof...(Args) == sizeof...(Fields) &&
+        detail::compact::all_of<std::is_convertible<Args, Fields>...>::value
+    >::type>
+    explicit compact_struct(Args&& ... args) noexcept
+    {
+        store_all_(tuple_unpack_sequence<Fields...>{}, std::forward<Args>(args)...);
+    }
+
+    template<std::size_t I>
+    inline element_type<I> get() const noexcept
+    {
+        return load_unaligned<element_type<I>>(m_data + offset<I>());
+    }
+
+    template<std::size_t I>
+    inline void set(const element_type<I>& value) noexcept
+    {
+        store_unaligned(m_data + offset<I>(), value);
+    }
+
+    /**
+     * @brief Reads record from memory location of bytes() length
+     */
+    inline void load(const void* src) noexcept
+    {
+        std::memcpy(m_data, src, sizeof(m_data));
+    }
+
+    /**
+     * @brief Writes record to memory location of bytes() length
+     */
+    inline void store(void* dst) const noexcept
+    {
+        std::memcpy(dst, m_data, sizeof(m_data));
+    }
+
+    inline types::memory_t* data() noexcept { return m_data; }
+    inline const types::memory_t* data() const noexcept { return m_data; }
+
+    /* Comparison operators */
+
+    inline friend bool operator==(
+        const compact_struct& lhs, const compact_struct& rhs) noexcept
+    {
+        return lhs.equal_(tuple_unpack_sequence<Fields...>{}, rhs);
+    }
+    inline friend bool operator!=(
+        const compact_struct& lhs, const compact_struct& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief Free function access to compact_struct field (used by structured bindings)
+ */
+template<std::size_t I, class ... Fields>
+inline typename compact_struct<Fields...>::template element_type<I>
+    get(const compact_struct<Fields...>& record) noexcept
+{
+    return record.template get<I>();
+}
+
+/**
+ * @brief Free function write to compact_struct field
+ */
+template<std::size_t I, class ... Fields>
+inline void set(compact_struct<Fields...>& record,
+    const typename compact_struct<Fields...>::template element_type<I>& value) noexcept
+{
+    record.template set<I>(value);
+}
+
+/**
+ * @brief Makes compact_struct with field types deduced from arguments
+ */
+template<class ... Fields>
+inline compact_struct<typename std::decay<Fields>::type...>
+    make_compact_struct(Fields&& ... fields) noexcept
+{
+    return compact_struct<typename std::decay<Fields>::type...>{
+        std::forward<Fields>(fields)...};
+}
+
+template<class ... Fields>
+using packed_tuple = compact_struct<Fields...>;
+
+} // namespace ecsl
+
+namespace std {
+
+template<class ... Fields>
+struct tuple_size<::ecsl::compact_struct<Fields...>> :
+    std::integral_constant<std::size_t, sizeof...(Fields)>
+{};
+
+template<std::size_t I, class ... Fields>
+struct tuple_element<I, ::ecsl::compact_struct<Fields...>>
+{
+    using type = typename ::ecsl::compact_struct<Fields...>::template element_type<I>;
+};
+
+} // namespace std
+#endif /* ECSL_COMPACT_STRUCT_HPP_ */
@@ -0,0 +1,446 @@
+#ifndef ECSL_COMPACT_VARINT_HPP_
+#define ECSL_COMPACT_VARINT_HPP_
+
+/**
+ * @file Varint.hpp
+ * Declares variable length integer codecs:
+ *  ecsl::varint - LEB128 encoding and zigzag mapping of signed integers
+ *  ecsl::stream_vbyte - Stream VByte encoding of 32-bit integers
+ *
+ * Stream VByte stores 2-bit length codes of 4 integers in one control byte.
+ * All control bytes go first followed by data bytes, so the decoder may
+ * expand 4 integers with single byte shuffle looked up by control byte.
+ * See: D. Lemire, N. Kurz, C. Rupp "Stream VByte: Faster Byte-Oriented
+ * Integer Compression" https://arxiv.org/abs/1709.08990
+ */
+
+/// STD
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+/// ECSL
+#include <ecsl/platform/Simd.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace varint {
+
+/**
+ * Maximal LEB128 encoded length of 32 and 64 bit integers
+ */
+constexpr std::size_t MAX_SIZE_32 = 5;
+constexpr std::size_t MAX_SIZE_64 = 10;
+
+/**
+ * @brief Maps signed integer to unsigned so that small magnitudes
+ * produce small values: 0, -1, 1, -2, 2 ... => 0, 1, 2, 3, 4 ...
+ */
+constexpr std::uint32_t zigzag_encode(std::int32_t value) noexcept
+{
+    return (static_cast<std::uint32_t>(value) << 1) ^
+        static_cast<std::uint32_t>(value >> 31);
+}
+constexpr std::uint64_t zigzag_encode(std::int64_t value) noexcept
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^
+        static_cast<std::uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Inverse of zigzag_encode
+ */
+constexpr std::int32_t zigzag_decode(std::uint32_t value) noexcept
+{
+    return static_cast<std::int32_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+constexpr std::int64_t zigzag_decode(std::uint64_t value) noexcept
+{
+    return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+/**
+ * @brief Length of LEB128 representation of value in bytes
+ */
+constexpr std::size_t size(std::uint64_t value) noexcept
+{
+    std::size_t r_{1};
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        ++r_;
+    }
+    return r_;
+}
+
+/**
+ * @brief Writes LEB128 representation of value
+ * @param[out] dst Buffer of at least size(value) bytes
+ * @return Count of bytes written
+ */
+inline std::size_t encode(std::uint64_t value, types::memory_t* dst) noexcept
+{
+    std::size_t i{0};
+    while (value >= 0x80)
+    {
+        dst[i++] = static_cast<types::memory_t>(value | 0x80);
+        value >>= 7;
+    }
+    dst[i++] = static_cast<types::memory_t>(value);
+    return i;
+}
+
+/**
+ * @brief Reads LEB128 representation of value
+ * @param[in] src Beginning of encoded value
+ * @param[in] end End of available input
+ * @param[out] value Decoded value
+ * @return Count of bytes read or 0 if input is truncated or overlong
+ */
+inline std::size_t decode(
+    const types::memory_t* src, const types::memory_t* end, std::uint64_t& value) noexcept
+{
+    std::uint64_t r_{0};
+    const auto limit_ = static_cast<std::size_t>(end - src) < MAX_SIZE_64 ?
+        static_cast<std::size_t>(end - src) : MAX_SIZE_64;
+    for (std::size_t i{0}; i < limit_; ++i)
+    {
+        const std::uint64_t byte_ = src[i];
+        r_ |= (byte_ & 0x7F) << (7 * i);
+        if (!(byte_ & 0x80))
+        {
+            //? The 10th byte may only carry the last bit of 64-bit value
+            if (i + 1 == MAX_SIZE_64 && byte_ > 1)
+            {
+                return 0;
+            }
+            value = r_;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Reads LEB128 representation of 32-bit value
+ * @return Count of bytes read or 0 if input is malformed or value overflows
+ */
+inline std::size_t decode(
+    const types::memory_t* src, const types::memory_t* end, std::uint32_t& value) noexcept
+{
+    std::uint64_t r_{0};
+    const auto n_ = decode(src, end, r_);
+    if (!n_ || r_ > 0xFFFFFFFFull)
+    {
+        return 0;
+    }
+    value = static_cast<std::uint32_t>(r_);
+    return n_;
+}
+
+/**
+ * @brief Writes count values in LEB128 representation one after another
+ * @param[out] dst Buffer of at least count * MAX_SIZE_* bytes
+ * @return Count of bytes written
+ */
+template<class T>
+inline typename std::enable_if<std::is_unsigned<T>::value, std::size_t>::type
+    encode(const T* src, std::size_t count, types::memory_t* dst) noexcept
+{
+    auto* out_ = dst;
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        out_ += encode(static_cast<std::uint64_t>(src[i]), out_);
+    }
+    return static_cast<std::size_t>(out_ - dst);
+}
+
+/**
+ * @brief Reads count values in LEB128 representation
+ * @return Count of bytes read or 0 if input is malformed
+ */
+template<class T>
+inline typename std::enable_if<
+    std::is_same<T, std::uint32_t>::value || std::is_same<T, std::uint64_t>::value,
+    std::size_t
+>::type decode(const types::memory_t* src, const types::memory_t* end,
+    T* dst, std::size_t count) noexcept
+{
+    const auto* in_ = src;
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        const auto n_ = decode(in_, end, dst[i]);
+        if (!n_)
+        {
+            return 0;
+        }
+        in_ += n_;
+    }
+    return static_cast<std::size_t>(in_ - src);
+}
+
+} // namespace varint
+
+namespace detail {
+namespace stream_vbyte {
+
+struct shuffle_t
+{
+    alignas(16) signed char m_data[16];
+};
+
+struct lengths_t
+{
+    types::memory_t m_data[256];
+};
+
+struct shuffles_t
+{
+    shuffle_t m_data[256];
+};
+
+constexpr std::size_t lane_length(unsigned control, unsigned lane) noexcept
+{
+    return ((control >> (2 * lane)) & 3) + 1;
+}
+
+constexpr lengths_t make_lengths() noexcept
+{
+    lengths_t r_{};
+    for (unsigned c{0}; c < 256; ++c)
+    {
+        r_.m_data[c] = static_cast<types::memory_t>(
+            lane_length(c, 0) + lane_length(c, 1) + lane_length(c, 2) + lane_length(c, 3));
+    }
+    return r_;
+}
+
+//? Expands packed bytes into 4 little-endian 32-bit lanes
+constexpr shuffles_t make_decode() noexcept
+{
+    shuffles_t r_{};
+    for (unsigned c{0}; c < 256; ++c)
+    {
+        unsigned off_{0};
+        for (unsigned lane{0}; lane < 4; ++lane)
+        {
+            const auto len_ = lane_length(c, lane);
+            for (unsigned j{0}; j < 4; ++j)
+            {
+                r_.m_data[c].m_data[4 * lane + j] = j < len_ ?
+                    static_cast<signed char>(off_ + j) : -1;
+            }
+            off_ += static_cast<unsigned>(len_);
+        }
+    }
+    return r_;
+}
+
+//? Packs significant bytes of 4 little-endian 32-bit lanes
+constexpr shuffles_t make_encode() noexcept
+{
+    shuffles_t r_{};
+    for (unsigned c{0}; c < 256; ++c)
+    {
+        for (unsigned i{0}; i < 16; ++i)
+        {
+            r_.m_data[c].m_data[i] = -1;
+        }
+        unsigned off_{0};
+        for (unsigned lane{0}; lane < 4; ++lane)
+        {
+            const auto len_ = lane_length(c, lane);
+            for (unsigned j{0}; j < len_; ++j)
+            {
+                r_.m_data[c].m_data[off_++] = static_cast<signed char>(4 * lane + j);
+            }
+        }
+    }
+    return r_;
+}
+
+/**
+ * Byte shuffles and data lengths for every control byte value
+ */
+struct tables
+{
+    static constexpr lengths_t LENGTHS = make_lengths();
+    static constexpr shuffles_t DECODE = make_decode();
+    static constexpr shuffles_t ENCODE = make_encode();
+};
+
+inline unsigned code(std::uint32_t value) noexcept
+{
+    return (value > 0xFFu) + (value > 0xFFFFu) + (value > 0xFFFFFFu);
+}
+
+inline std::size_t control_bytes(std::size_t count) noexcept
+{
+    return (count + 3) / 4;
+}
+
+} // namespace stream_vbyte
+} // namespace detail
+
+namespace stream_vbyte {
+
+/**
+ * @brief Maximal length of Stream VByte encoded count integers
+ */
+constexpr std::size_t max_encoded_size(std::size_t count) noexcept
+{
+    return (count + 3) / 4 + count * sizeof(std::uint32_t);
+}
+
+/**
+ * @brief Reference (scalar) encoder
+ * @param[out] dst Buffer of at least max_encoded_size(count) bytes
+ * @return Count of bytes written
+ */
+inline std::size_t encode_scalar(
+    const std::uint32_t* src, std::size_t count, types::memory_t* dst) noexcept
+{
+    using namespace detail::stream_vbyte;
+    auto* control_ = dst;
+    auto* data_ = dst + control_bytes(count);
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        const auto code_ = code(src[i]);
+        if (i % 4 == 0)
+        {
+            control_[i / 4] = 0;
+        }
+        control_[i / 4] |= static_cast<types::memory_t>(code_ << (2 * (i % 4)));
+        for (unsigned j{0}; j <= code_; ++j)
+        {
+            *data_++ = static_cast<types::memory_t>(src[i] >> (8 * j));
+        }
+    }
+    return static_cast<std::size_t>(data_ - dst);
+}
+
+/**
+ * @brief Reference (scalar) decoder
+ * @return Count of bytes read
+ */
+inline std::size_t decode_scalar(
+    const types::memory_t* src, std::uint32_t* dst, std::size_t count) noexcept
+{
+    using namespace detail::stream_vbyte;
+    const auto* control_ = src;
+    const auto* data_ = src + control_bytes(count);
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        const unsigned code_ = (control_[i / 4] >> (2 * (i % 4))) & 3;
+        std::uint32_t v_{0};
+        for (unsigned j{0}; j <= code_; ++j)
+        {
+            v_ |= static_cast<std::uint32_t>(*data_++) << (8 * j);
+        }
+        dst[i] = v_;
+    }
+    return static_cast<std::size_t>(data_ - src);
+}
+
+/**
+ * @brief Encodes count integers.
+ * Uses SSSE3 byte shuffles (4 integers per step) when enabled
+ * for the translation unit.
+ * @param[out] dst Buffer of at least max_encoded_size(count) bytes
+ * @return Count of bytes written
+ */
+inline std::size_t encode(
+    const std::uint32_t* src, std::size_t count, types::memory_t* dst) noexcept
+{
+#if defined(ECSL_SIMD_SSSE3)
+    using namespace detail::stream_vbyte;
+    auto* control_ = dst;
+    auto* data_ = dst + control_bytes(count);
+    const std::size_t quads_ = count / 4;
+    const __m128i bias_ = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i t1_ = _mm_set1_epi32(static_cast<int>(0x800000FFu));
+    const __m128i t2_ = _mm_set1_epi32(static_cast<int>(0x8000FFFFu));
+    const __m128i t3_ = _mm_set1_epi32(static_cast<int>(0x80FFFFFFu));
+    const __m128i gather_ = _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1);
+    for (std::size_t q{0}; q < quads_; ++q)
+    {
+        const __m128i v_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * q));
+        //? Unsigned compares via sign bias, each true compare adds 1 to code
+        const __m128i b_ = _mm_xor_si128(v_, bias_);
+        const __m128i codes_ = _mm_sub_epi32(_mm_sub_epi32(_mm_sub_epi32(
+            _mm_setzero_si128(),
+            _mm_cmpgt_epi32(b_, t1_)),
+            _mm_cmpgt_epi32(b_, t2_)),
+            _mm_cmpgt_epi32(b_, t3_));
+        const auto c4_ = static_cast<std::uint32_t>(
+            _mm_cvtsi128_si32(_mm_shuffle_epi8(codes_, gather_)));
+        const auto control_byte_ = static_cast<unsigned>(
+            (c4_ | (c4_ >> 6) | (c4_ >> 12) | (c4_ >> 18)) & 0xFF);
+        control_[q] = static_cast<types::memory_t>(control_byte_);
+        const __m128i shuffle_ = _mm_load_si128(
+            reinterpret_cast<const __m128i*>(tables::ENCODE.m_data[control_byte_].m_data));
+        //? Full 16 bytes store stays within max_encoded_size for full quads
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data_), _mm_shuffle_epi8(v_, shuffle_));
+        data_ += tables::LENGTHS.m_data[control_byte_];
+    }
+    const auto tail_ = count - 4 * quads_;
+    if (tail_)
+    {
+        types::memory_t buffer_[max_encoded_size(4)];
+        const auto n_ = encode_scalar(src + 4 * quads_, tail_, buffer_);
+        control_[quads_] = buffer_[0];
+        std::memcpy(data_, buffer_ + 1, n_ - 1);
+        data_ += n_ - 1;
+    }
+    return static_cast<std::size_t>(data_ - dst);
+#else
+    return encode_scalar(src, count, dst);
+#endif
+}
+
+/**
+ * @brief Decodes count integers.
+ * Uses SSSE3 byte shuffles (4 integers per step) when enabled
+ * for the translation unit. Never reads past the encoded data.
+ * @return Count of bytes read
+ */
+inline std::size_t decode(
+    const types::memory_t* src, std::uint32_t* dst, std::size_t count) noexcept
+{
+#if defined(ECSL_SIMD_SSSE3)
+    using namespace detail::stream_vbyte;
+    const auto* control_ = src;
+    const auto* data_ = src + control_bytes(count);
+    const std::size_t quads_ = count / 4;
+    //? 16 bytes load is in bounds while 3 more full quads follow:
+    //? each of them occupies at least 4 bytes
+    const std::size_t simd_quads_ = quads_ > 3 ? quads_ - 3 : 0;
+    std::size_t q{0};
+    for (; q < simd_quads_; ++q)
+    {
+        const unsigned c_ = control_[q];
+        const __m128i shuffle_ = _mm_load_si128(
+            reinterpret_cast<const __m128i*>(tables::DECODE.m_data[c_].m_data));
+        const __m128i v_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data_));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * q), _mm_shuffle_epi8(v_, shuffle_));
+        data_ += tables::LENGTHS.m_data[c_];
+    }
+    for (std::size_t i{4 * q}; i < count; ++i)
+    {
+        const unsigned code_ = (control_[i / 4] >> (2 * (i % 4))) & 3;
+        std::uint32_t v_{0};
+        for (unsigned j{0}; j <= code_; ++j)
+        {
+            v_ |= static_cast<std::uint32_t>(*data_++) << (8 * j);
+        }
+        dst[i] = v_;
+    }
+    return static_cast<std::size_t>(data_ - src);
+#else
+    return decode_scalar(src, dst, count);
+#endif
+}
+
+} // namespace stream_vbyte
+} // namespace ecsl
+#endif /* ECSL_COMPACT_VARINT_HPP_ */
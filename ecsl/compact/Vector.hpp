@@ -0,0 +1,465 @@
+#ifndef ECSL_COMPACT_VECTOR_HPP_
+#define ECSL_COMPACT_VECTOR_HPP_
+
+/**
+ * @file Vector.hpp
+ * Declares container of integers or pointers stored back-to-back with
+ * reduced byte width and bulk (vectorized) conversion to/from native arrays
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+/// ECSL
+#include <ecsl/platform/Simd.hpp>
+#include <ecsl/type_traits/MinimalInteger.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace detail {
+namespace compact {
+
+/**
+ * Reads WIDTH little-endian bytes into the low bytes of U
+ */
+template<class U, std::size_t WIDTH>
+inline U load_bytes(const types::memory_t* src) noexcept
+{
+    U r_{0};
+    for (std::size_t i{0}; i < WIDTH; ++i)
+    {
+        r_ |= static_cast<U>(static_cast<U>(src[i]) << (CHAR_BIT * i));
+    }
+    return r_;
+}
+
+/**
+ * Writes WIDTH low bytes of U in little-endian order
+ */
+template<class U, std::size_t WIDTH>
+inline void store_bytes(types::memory_t* dst, U value) noexcept
+{
+    for (std::size_t i{0}; i < WIDTH; ++i)
+    {
+        dst[i] = static_cast<types::memory_t>(value >> (CHAR_BIT * i));
+    }
+}
+
+template<class T, class U>
+inline typename std::enable_if<std::is_integral<T>::value, U>::type
+    to_bits(T value) noexcept
+{
+    return static_cast<U>(value);
+}
+
+template<class T, class U>
+inline typename std::enable_if<std::is_pointer<T>::value, U>::type
+    to_bits(T value) noexcept
+{
+    return static_cast<U>(reinterpret_cast<std::uintptr_t>(value));
+}
+
+template<class T, class U, std::size_t WIDTH>
+inline typename std::enable_if<std::is_integral<T>::value, T>::type
+    from_bits(U value) noexcept
+{
+    if constexpr (std::is_signed<T>::value && WIDTH < sizeof(U))
+    {   //? Sign extension: relies on arithmetic right shift of signed values
+        using S = typename std::make_signed<U>::type;
+        constexpr std::size_t SHIFT_ = (sizeof(U) - WIDTH) * CHAR_BIT;
+        return static_cast<T>(static_cast<S>(static_cast<U>(value << SHIFT_)) >> SHIFT_);
+    }
+    else
+    {
+        return static_cast<T>(value);
+    }
+}
+
+template<class T, class U, std::size_t WIDTH>
+inline typename std::enable_if<std::is_pointer<T>::value, T>::type
+    from_bits(U value) noexcept
+{
+    return reinterpret_cast<T>(static_cast<std::uintptr_t>(value));
+}
+
+/**
+ * pshufb masks for conversion between SIZE-byte and WIDTH-byte elements
+ * inside of 16 byte vector. Negative index zeroes the destination byte.
+ * If HIGH is true widened bytes are placed at the top of the element
+ * (sign extension is done later with arithmetic shift).
+ */
+template<std::size_t SIZE, std::size_t WIDTH, bool HIGH>
+struct shuffle_masks
+{
+    static constexpr std::size_t LANES = 16 / SIZE;
+
+    struct mask_t
+    {
+        alignas(16) signed char m_data[16];
+    };
+
+    static constexpr mask_t widen() noexcept
+    {
+        mask_t r_{};
+        for (std::size_t e{0}; e < LANES; ++e)
+        {
+            for (std::size_t j{0}; j < SIZE; ++j)
+            {
+                constexpr std::size_t PAD_ = HIGH ? SIZE - WIDTH : 0;
+                r_.m_data[e * SIZE + j] = (j >= PAD_ && j - PAD_ < WIDTH) ?
+                    static_cast<signed char>(e * WIDTH + j - PAD_) : -128;
+            }
+        }
+        return r_;
+    }
+
+    static constexpr mask_t narrow() noexcept
+    {
+        mask_t r_{};
+        for (std::size_t i{0}; i < 16; ++i)
+        {
+            r_.m_data[i] = -128;
+        }
+        for (std::size_t e{0}; e < LANES; ++e)
+        {
+            for (std::size_t j{0}; j < WIDTH; ++j)
+            {
+                r_.m_data[e * WIDTH + j] = static_cast<signed char>(e * SIZE + j);
+            }
+        }
+        return r_;
+    }
+
+    static constexpr mask_t WIDEN = widen();
+    static constexpr mask_t NARROW = narrow();
+};
+
+#if defined(ECSL_SIMD_SSSE3)
+
+template<std::size_t SIZE, int SHIFT>
+inline __m128i srai_(__m128i v) noexcept
+{
+    if constexpr (SIZE == 2) { return _mm_srai_epi16(v, SHIFT); }
+    else if constexpr (SIZE == 4) { return _mm_srai_epi32(v, SHIFT); }
+#   if defined(ECSL_SIMD_AVX512VL)
+    else { return _mm_srai_epi64(v, SHIFT); }
+#   else
+    else { return v; }
+#   endif
+}
+
+#   if defined(ECSL_SIMD_AVX2)
+template<std::size_t SIZE, int SHIFT>
+inline __m256i srai_(__m256i v) noexcept
+{
+    if constexpr (SIZE == 2) { return _mm256_srai_epi16(v, SHIFT); }
+    else if constexpr (SIZE == 4) { return _mm256_srai_epi32(v, SHIFT); }
+#       if defined(ECSL_SIMD_AVX512VL)
+    else { return _mm256_srai_epi64(v, SHIFT); }
+#       else
+    else { return v; }
+#       endif
+}
+#   endif
+
+/**
+ * Vectorized widening of WIDTH-byte elements to U.
+ * @return Count of converted elements (the tail is left to scalar code)
+ */
+template<class U, std::size_t WIDTH, bool SIGNED>
+inline std::size_t widen_simd(const types::memory_t* src, U* dst, std::size_t count) noexcept
+{
+    constexpr std::size_t SIZE_ = sizeof(U);
+    constexpr std::size_t LANES_ = 16 / SIZE_;
+    constexpr int SHIFT_ = static_cast<int>((SIZE_ - WIDTH) * CHAR_BIT);
+    using masks_t = shuffle_masks<SIZE_, WIDTH, SIGNED>;
+    const __m128i mask_ = _mm_load_si128(
+        reinterpret_cast<const __m128i*>(masks_t::WIDEN.m_data));
+    const std::size_t bytes_ = count * WIDTH;
+    std::size_t i{0};
+#   if defined(ECSL_SIMD_AVX2)
+    const __m256i mask2_ = _mm256_broadcastsi128_si256(mask_);
+    for (; i + 2 * LANES_ <= count && (i + LANES_) * WIDTH + 16 <= bytes_; i += 2 * LANES_)
+    {
+        const __m128i lo_ = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(src + i * WIDTH));
+        const __m128i hi_ = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(src + (i + LANES_) * WIDTH));
+        __m256i v_ = _mm256_shuffle_epi8(
+            _mm256_inserti128_si256(_mm256_castsi128_si256(lo_), hi_, 1), mask2_);
+        if constexpr (SIGNED)
+        {
+            v_ = srai_<SIZE_, SHIFT_>(v_);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v_);
+    }
+#   endif
+    for (; i + LANES_ <= count && i * WIDTH + 16 <= bytes_; i += LANES_)
+    {
+        __m128i v_ = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(src + i * WIDTH)), mask_);
+        if constexpr (SIGNED)
+        {
+            v_ = srai_<SIZE_, SHIFT_>(v_);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v_);
+    }
+    return i;
+}
+
+/**
+ * Vectorized narrowing of U elements to WIDTH bytes.
+ * @return Count of converted elements (the tail is left to scalar code)
+ */
+template<class U, std::size_t WIDTH>
+inline std::size_t narrow_simd(const U* src, types::memory_t* dst, std::size_t count) noexcept
+{
+    constexpr std::size_t LANES_ = 16 / sizeof(U);
+    using masks_t = shuffle_masks<sizeof(U), WIDTH, false>;
+    const __m128i mask_ = _mm_load_si128(
+        reinterpret_cast<const __m128i*>(masks_t::NARROW.m_data));
+    //? Each store writes full 16 bytes: the garbage past the converted
+    //? elements is overwritten by the next store, so stores must not
+    //? reach past the end of the destination range
+    const std::size_t bytes_ = count * WIDTH;
+    std::size_t i{0};
+#   if defined(ECSL_SIMD_AVX2)
+    const __m256i mask2_ = _mm256_broadcastsi128_si256(mask_);
+    for (; i + 2 * LANES_ <= count && (i + LANES_) * WIDTH + 16 <= bytes_; i += 2 * LANES_)
+    {
+        const __m256i v_ = _mm256_shuffle_epi8(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(src + i)), mask2_);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * WIDTH),
+            _mm256_castsi256_si128(v_));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i + LANES_) * WIDTH),
+            _mm256_extracti128_si256(v_, 1));
+    }
+#   endif
+    for (; i + LANES_ <= count && i * WIDTH + 16 <= bytes_; i += LANES_)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * WIDTH),
+            _mm_shuffle_epi8(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + i)), mask_));
+    }
+    return i;
+}
+
+#endif /* ECSL_SIMD_SSSE3 */
+
+/**
+ * Defines whether vectorized conversion is available for given parameters
+ */
+template<class T, class U, std::size_t WIDTH>
+struct vector_simd_enabled
+{
+#if defined(ECSL_SIMD_SSSE3)
+    //? There is no 64-bit arithmetic shift before AVX-512 for sign extension
+#   if defined(ECSL_SIMD_AVX512VL)
+    static constexpr bool SIGN_ = true;
+#   else
+    static constexpr bool SIGN_ = !std::is_signed<T>::value || sizeof(U) != 8;
+#   endif
+    static constexpr bool value =
+        (sizeof(U) == 2 || sizeof(U) == 4 || sizeof(U) == 8) &&
+        WIDTH < sizeof(U) && SIGN_;
+#else
+    static constexpr bool value = false;
+#endif
+};
+
+} // namespace compact
+} // namespace detail
+
+/**
+ * @brief Dense vector of integers or pointers each stored in Width bytes
+ * Values are stored back-to-back in little-endian byte order.
+ * Signed values are sign extended on load, pointers and unsigned values are
+ * zero extended. Bulk encode/decode use SSSE3/AVX2 byte shuffles when enabled
+ * for the translation unit and a scalar loop otherwise.
+ * @tparam T Integral or pointer type
+ * @tparam Width Count of bytes to store per value in range [1:sizeof(T)]
+ */
+template<class T, std::size_t Width = sizeof(T)>
+class compact_vector
+{
+    static_assert(std::is_integral<T>::value || std::is_pointer<T>::value,
+        "compact_vector may hold only integral or pointer types");
+    static_assert(Width != 0 && Width <= sizeof(T),
+        "compact_vector Width must be in range [1:sizeof(T)]");
+
+    using bits_type = unsigned_minimal_integer_t<T>;
+    using simd_t = detail::compact::vector_simd_enabled<T, bits_type, Width>;
+
+    std::vector<types::memory_t> m_bytes;
+
+    static inline T load_(const types::memory_t* src) noexcept
+    {
+        using namespace detail::compact;
+        return from_bits<T, bits_type, Width>(load_bytes<bits_type, Width>(src));
+    }
+
+    static inline void store_(types::memory_t* dst, T value) noexcept
+    {
+        using namespace detail::compact;
+        store_bytes<bits_type, Width>(dst, to_bits<T, bits_type>(value));
+    }
+
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+    static constexpr size_type width() noexcept { return Width; }
+
+    compact_vector() = default;
+    explicit compact_vector(size_type count) : m_bytes(count * Width) {}
+    compact_vector(const value_type* src, size_type count) :
+        m_bytes(count * Width)
+    {
+        encode(src, count);
+    }
+
+    inline size_type size() const noexcept { return m_bytes.size() / Width; }
+    inline bool empty() const noexcept { return m_bytes.empty(); }
+    inline size_type capacity() const noexcept { return m_bytes.capacity() / Width; }
+
+    inline void reserve(size_type count) { m_bytes.reserve(count * Width); }
+    inline void resize(size_type count) { m_bytes.resize(count * Width); }
+    inline void clear() noexcept { m_bytes.clear(); }
+    inline void shrink_to_fit() { m_bytes.shrink_to_fit(); }
+
+    /**
+     * @brief Size of stored binary representation in bytes
+     */
+    inline size_type bytes() const noexcept { return m_bytes.size(); }
+    inline types::memory_t* data() noexcept { return m_bytes.data(); }
+    inline const types::memory_t* data() const noexcept { return m_bytes.data(); }
+
+    inline value_type get(size_type position) const noexcept
+    {
+        return load_(m_bytes.data() + position * Width);
+    }
+
+    inline void set(size_type position, value_type value) noexcept
+    {
+        store_(m_bytes.data() + position * Width, value);
+    }
+
+    inline value_type operator[](size_type position) const noexcept
+    {
+        return get(position);
+    }
+
+    inline value_type at(size_type position) const
+    {
+        if (position < size())
+        {
+            return get(position);
+        }
+        throw std::out_of_range{"compact_vector range check failed"};
+    }
+
+    inline value_type front() const noexcept { return get(0); }
+    inline value_type back() const noexcept { return get(size() - 1); }
+
+    inline void push_back(value_type value)
+    {
+        m_bytes.resize(m_bytes.size() + Width);
+        store_(m_bytes.data() + m_bytes.size() - Width, value);
+    }
+
+    inline void pop_back() noexcept
+    {
+        m_bytes.resize(m_bytes.size() - Width);
+    }
+
+    /**
+     * @brief Bulk load of values [first, first + count) into dst
+     */
+    void decode(value_type* dst, size_type count, size_type first = 0) const noexcept
+    {
+        if (!count)
+        {   //? data() of an empty vector may be null, memcpy must not see it
+            return;
+        }
+        const types::memory_t* src_ = m_bytes.data() + first * Width;
+        if constexpr (Width == sizeof(T))
+        {
+            std::memcpy(dst, src_, count * Width);
+        }
+        else
+        {
+            size_type i{0};
+#if defined(ECSL_SIMD_SSSE3)
+            if constexpr (simd_t::value)
+            {
+                i = detail::compact::widen_simd<bits_type, Width, std::is_signed<T>::value>(
+                    src_, reinterpret_cast<bits_type*>(dst), count);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                dst[i] = load_(src_ + i * Width);
+            }
+        }
+    }
+
+    /**
+     * @brief Bulk store of count values from src into [first, first + count)
+     * The range must be within the current size()
+     */
+    void encode(const value_type* src, size_type count, size_type first = 0) noexcept
+    {
+        if (!count)
+        {   //? data() of an empty vector may be null, memcpy must not see it
+            return;
+        }
+        types::memory_t* dst_ = m_bytes.data() + first * Width;
+        if constexpr (Width == sizeof(T))
+        {
+            std::memcpy(dst_, src, count * Width);
+        }
+        else
+        {
+            size_type i{0};
+#if defined(ECSL_SIMD_SSSE3)
+            if constexpr (simd_t::value)
+            {
+                i = detail::compact::narrow_simd<bits_type, Width>(
+                    reinterpret_cast<const bits_type*>(src), dst_, count);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                store_(dst_ + i * Width, src[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Appends count values from src to the end of vector
+     */
+    void append(const value_type* src, size_type count)
+    {
+        const auto first_ = size();
+        resize(first_ + count);
+        encode(src, count, first_);
+    }
+
+    inline friend bool operator==(
+        const compact_vector& lhs, const compact_vector& rhs) noexcept
+    {
+        return lhs.m_bytes == rhs.m_bytes;
+    }
+    inline friend bool operator!=(
+        const compact_vector& lhs, const compact_vector& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+} // namespace ecsl
+#endif /* ECSL_COMPACT_VECTOR_HPP_ */
@@ -12,6 +12,17 @@ namespace ecsl {
 namespace detail {
 namespace compact {
 
+/**
+ * Conjunction of boolean traits
+ */
+template<class ... B>
+struct all_of : std::true_type {};
+
+template<class B, class ... Bs>
+struct all_of<B, Bs...> :
+    std::integral_constant<bool, B::value && all_of<Bs...>::value>
+{};
+
 struct as_result {};
 struct as_param {};
 
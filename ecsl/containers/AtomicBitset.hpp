@@ -0,0 +1,249 @@
+#ifndef ECSL_CONTAINERS_ATOMIC_BITSET_HPP_
+#define ECSL_CONTAINERS_ATOMIC_BITSET_HPP_
+
+/**
+ * @file AtomicBitset.hpp
+ * Declares run time sized bit vector with lock-free concurrent access
+ *
+ * All operations are lock-free on platforms with lock-free 64-bit atomics.
+ * claim_first_zero() makes the bitset a lock-free slot allocator: a zero
+ * bit is found with ctz and claimed with a single CAS, a failed CAS reloads
+ * only the contended word. Every thread starts its scan from its own word
+ * (derived from the thread id), so threads mostly claim in different words
+ * and cache lines.
+ */
+
+/// STD
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+/// ECSL
+#include <ecsl/containers/MinimalBitset.hpp>
+
+namespace ecsl {
+namespace containers {
+
+/**
+ * @brief Fixed size (set at construction) bit vector of atomic words
+ */
+class atomic_bitset
+{
+  public:
+    using word_type     = std::uint64_t;
+    using size_type     = std::size_t;
+
+    static constexpr size_type BITS_IN_WORD = sizeof(word_type) * CHAR_BIT;
+
+  private:
+    std::unique_ptr<std::atomic<word_type>[]> m_words;
+    size_type m_bits;
+    size_type m_word_count;
+
+    static constexpr word_type bit_mask_(size_type position) noexcept
+    {
+        return word_type{1} << (position % BITS_IN_WORD);
+    }
+
+    //? Bits past size() are kept set, so they are never claimed
+    inline word_type padding_() const noexcept
+    {
+        return m_bits % BITS_IN_WORD ?
+            ~word_type{0} << (m_bits % BITS_IN_WORD) : word_type{0};
+    }
+
+    /**
+     * Start word of claim_first_zero scan for the calling thread
+     */
+    inline size_type thread_hint_() const noexcept
+    {
+        thread_local const size_type seed_ =
+            std::hash<std::thread::id>{}(std::this_thread::get_id());
+        return m_word_count ? seed_ % m_word_count : 0;
+    }
+
+  public:
+    explicit atomic_bitset(size_type bits) :
+        m_words{new std::atomic<word_type>[(bits + BITS_IN_WORD - 1) / BITS_IN_WORD]},
+        m_bits{bits},
+        m_word_count{(bits + BITS_IN_WORD - 1) / BITS_IN_WORD}
+    {
+        for (size_type i{0}; i < m_word_count; ++i)
+        {
+            m_words[i].store(0, std::memory_order_relaxed);
+        }
+        if (m_word_count)
+        {
+            m_words[m_word_count - 1].store(padding_(), std::memory_order_relaxed);
+        }
+    }
+
+    atomic_bitset(const atomic_bitset&) = delete;
+    atomic_bitset& operator=(const atomic_bitset&) = delete;
+
+    inline size_type size() const noexcept { return m_bits; }
+    inline size_type word_count() const noexcept { return m_word_count; }
+
+    /* Single bit access: positions must be less than size() */
+
+    inline bool test(size_type position,
+        std::memory_order order = std::memory_order_acquire) const noexcept
+    {
+        return m_words[position / BITS_IN_WORD].load(order) & bit_mask_(position);
+    }
+
+    bool at(size_type position) const
+    {
+        if (position < m_bits)
+        {
+            return test(position);
+        }
+        throw std::out_of_range{"atomic_bitset range check failed"};
+    }
+
+    inline void set(size_type position,
+        std::memory_order order = std::memory_order_release) noexcept
+    {
+        m_words[position / BITS_IN_WORD].fetch_or(bit_mask_(position), order);
+    }
+
+    inline void reset(size_type position,
+        std::memory_order order = std::memory_order_release) noexcept
+    {
+        m_words[position / BITS_IN_WORD].fetch_and(~bit_mask_(position), order);
+    }
+
+    /**
+     * @brief Sets the bit
+     * @return Previous value of the bit
+     */
+    inline bool test_and_set(size_type position,
+        std::memory_order order = std::memory_order_acq_rel) noexcept
+    {
+        const auto mask_ = bit_mask_(position);
+        return m_words[position / BITS_IN_WORD].fetch_or(mask_, order) & mask_;
+    }
+
+    /**
+     * @brief Resets the bit
+     * @return Previous value of the bit
+     */
+    inline bool test_and_reset(size_type position,
+        std::memory_order order = std::memory_order_acq_rel) noexcept
+    {
+        const auto mask_ = bit_mask_(position);
+        return m_words[position / BITS_IN_WORD].fetch_and(~mask_, order) & mask_;
+    }
+
+    /* Word access: bits past size() in the last word read as set */
+
+    inline word_type load_word(size_type word,
+        std::memory_order order = std::memory_order_acquire) const noexcept
+    {
+        return m_words[word].load(order);
+    }
+
+    /**
+     * @brief Atomically ors mask into the word
+     * @return Previous value of the word
+     */
+    inline word_type fetch_or(size_type word, word_type mask,
+        std::memory_order order = std::memory_order_acq_rel) noexcept
+    {
+        return m_words[word].fetch_or(mask, order);
+    }
+
+    /**
+     * @brief Atomically ands mask into the word (padding bits stay set)
+     * @return Previous value of the word
+     */
+    inline word_type fetch_and(size_type word, word_type mask,
+        std::memory_order order = std::memory_order_acq_rel) noexcept
+    {
+        if (word + 1 == m_word_count)
+        {
+            mask |= padding_();
+        }
+        return m_words[word].fetch_and(mask, order);
+    }
+
+    /**
+     * @brief Finds a zero bit starting from the word hint and sets it
+     * @return Position of the claimed bit or size() if all bits are set
+     */
+    size_type claim_first_zero(size_type hint) noexcept
+    {
+        for (size_type n_{0}; n_ < m_word_count; ++n_)
+        {
+            const auto word_ = (hint + n_) % m_word_count;
+            auto& atomic_ = m_words[word_];
+            auto value_ = atomic_.load(std::memory_order_relaxed);
+            while (~value_)
+            {
+                const auto bit_ = detail::minimal_bitset::lowest_bit_(~value_);
+                //? On failure value_ is reloaded and the word is rescanned
+                if (atomic_.compare_exchange_weak(value_, value_ | (word_type{1} << bit_),
+                        std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    return word_ * BITS_IN_WORD + bit_;
+                }
+            }
+        }
+        return m_bits;
+    }
+
+    /**
+     * @brief Finds a zero bit starting from the calling thread's word and sets it
+     * @return Position of the claimed bit or size() if all bits are set
+     */
+    inline size_type claim_first_zero() noexcept
+    {
+        return claim_first_zero(thread_hint_());
+    }
+
+    /**
+     * @brief Resets the bit claimed by claim_first_zero
+     */
+    inline void release(size_type position) noexcept
+    {
+        reset(position, std::memory_order_release);
+    }
+
+    /**
+     * @brief Count of set bits (not a consistent snapshot under concurrent writes)
+     */
+    size_type count() const noexcept
+    {
+        size_type r_{0};
+        for (size_type i{0}; i < m_word_count; ++i)
+        {
+            r_ += detail::minimal_bitset::popcount_(m_words[i].load(std::memory_order_relaxed));
+        }
+        return m_word_count ? r_ - detail::minimal_bitset::popcount_(padding_()) : 0;
+    }
+
+    /**
+     * @brief Clears all bits (must not race with other writers)
+     */
+    void reset() noexcept
+    {
+        for (size_type i{0}; i < m_word_count; ++i)
+        {
+            m_words[i].store(0, std::memory_order_relaxed);
+        }
+        if (m_word_count)
+        {
+            m_words[m_word_count - 1].store(padding_(), std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace containers
+
+using atomic_bitset_t = containers::atomic_bitset;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_ATOMIC_BITSET_HPP_ */
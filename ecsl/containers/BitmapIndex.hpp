@@ -0,0 +1,562 @@
+#ifndef ECSL_CONTAINERS_BITMAP_INDEX_HPP_
+#define ECSL_CONTAINERS_BITMAP_INDEX_HPP_
+
+/**
+ * @file BitmapIndex.hpp
+ * Declares bitmap indexes of a column and fused evaluation of predicates
+ * over them
+ *
+ * Row sets are dynamic_bitset of the row count (bit i is row i):
+ *  bitmap_index<T>      - one row set per distinct value (equality and IN)
+ *  bit_sliced_index<T>  - one row set per bit of an unsigned value, range
+ *                         predicates by bit-sliced comparison and sums
+ *  bitmap_expression    - AND/OR/XOR/NOT tree over row sets
+ * Expressions and comparisons are evaluated in chunks of 4 KiB of words:
+ * every operand chunk is combined while it is in L1, so a predicate
+ * touches each input word once and writes each result word once
+ * (count() writes nothing).
+ *
+ * Sources:
+ *  P. O'Neil, D. Quass "Improved Query Performance with Variant Indexes"
+ *  SIGMOD 1997
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+/// ECSL
+#include <ecsl/containers/DynamicBitset.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace bitmap_index {
+
+using word_t = dynamic_bitset::word_t;
+
+//? 4 KiB per operand: the evaluation stack of a few operands stays in L1
+constexpr std::size_t CHUNK_WORDS = 512;
+constexpr std::size_t BITS_IN_WORD = sizeof(word_t) * CHAR_BIT;
+//? dynamic_bitset storage is padded to blocks of 8 words
+constexpr std::size_t BLOCK_WORDS = 8;
+
+inline std::size_t storage_words(const containers::dynamic_bitset& bits) noexcept
+{
+    return (bits.word_count() + BLOCK_WORDS - 1) / BLOCK_WORDS * BLOCK_WORDS;
+}
+
+/**
+ * Clears the bits past size() set by negation
+ */
+inline void clear_padding(containers::dynamic_bitset& bits) noexcept
+{
+    const auto words_ = bits.word_count();
+    if (!words_)
+    {
+        return;
+    }
+    if (bits.size() % BITS_IN_WORD)
+    {
+        bits.data()[words_ - 1] &= (word_t{1} << (bits.size() % BITS_IN_WORD)) - 1;
+    }
+    for (auto i = words_; i < storage_words(bits); ++i)
+    {
+        bits.data()[i] = 0;
+    }
+}
+
+enum class op_code
+{
+    PUSH,
+    AND,
+    OR,
+    XOR,
+    AND_NOT,
+    NOT,
+};
+
+struct op
+{
+    op_code m_code;
+    const containers::dynamic_bitset* m_operand;
+};
+
+} // namespace bitmap_index
+} // namespace detail
+
+/**
+ * @brief Predicate over row sets of the same size
+ * The expression refers to the row sets, they must outlive it.
+ */
+class bitmap_expression
+{
+    using op_t      = detail::bitmap_index::op;
+    using op_code   = detail::bitmap_index::op_code;
+    using word_t    = detail::bitmap_index::word_t;
+
+  public:
+    using size_type = std::size_t;
+
+  private:
+    //? Reverse Polish program: PUSH pushes an operand, operators pop
+    std::vector<op_t> m_program;
+    size_type m_bits;
+    size_type m_depth;
+
+    bitmap_expression() noexcept : m_bits{0}, m_depth{0} {}
+
+    static bitmap_expression binary_(const bitmap_expression& lhs,
+        const bitmap_expression& rhs, op_code code)
+    {
+        if (lhs.m_bits != rhs.m_bits)
+        {
+            throw std::out_of_range{"bitmap_expression range check failed"};
+        }
+        bitmap_expression r_;
+        r_.m_bits = lhs.m_bits;
+        r_.m_program.reserve(lhs.m_program.size() + rhs.m_program.size() + 1);
+        r_.m_program = lhs.m_program;
+        r_.m_program.insert(r_.m_program.end(), rhs.m_program.begin(), rhs.m_program.end());
+        r_.m_program.push_back(op_t{code, nullptr});
+        r_.m_depth = lhs.m_depth > rhs.m_depth + 1 ? lhs.m_depth : rhs.m_depth + 1;
+        return r_;
+    }
+
+    /**
+     * Evaluates words [begin, begin + count) into the first stack slot
+     * @return Pointer to the result words (a stack slot or an operand)
+     */
+    const word_t* evaluate_chunk_(size_type begin, size_type count, word_t* stack,
+        std::vector<const word_t*>& slots) const
+    {
+        using namespace detail::dynamic_bitset;
+        //? Operands are read in place until an operator writes them
+        slots.clear();
+        auto own_ = [&](size_type slot)
+        {
+            auto* buffer_ = stack + slot * detail::bitmap_index::CHUNK_WORDS;
+            if (slots[slot] != buffer_)
+            {
+                std::memcpy(buffer_, slots[slot], count * sizeof(word_t));
+                slots[slot] = buffer_;
+            }
+            return buffer_;
+        };
+        for (const auto& op_ : m_program)
+        {
+            const auto top_ = slots.size() - 1;
+            switch (op_.m_code)
+            {
+                case op_code::PUSH:
+                    slots.push_back(op_.m_operand->data() + begin);
+                    break;
+                case op_code::NOT:
+                {
+                    auto* dst_ = own_(top_);
+                    for (size_type i{0}; i < count; ++i)
+                    {
+                        dst_[i] = ~dst_[i];
+                    }
+                    break;
+                }
+                case op_code::AND:
+                    apply<bit_op::AND>(own_(top_ - 1), slots[top_], count);
+                    slots.pop_back();
+                    break;
+                case op_code::OR:
+                    apply<bit_op::OR>(own_(top_ - 1), slots[top_], count);
+                    slots.pop_back();
+                    break;
+                case op_code::XOR:
+                    apply<bit_op::XOR>(own_(top_ - 1), slots[top_], count);
+                    slots.pop_back();
+                    break;
+                case op_code::AND_NOT:
+                    apply<bit_op::AND_NOT>(own_(top_ - 1), slots[top_], count);
+                    slots.pop_back();
+                    break;
+            }
+        }
+        return slots.front();
+    }
+
+  public:
+    /**
+     * @brief Expression of a single row set
+     */
+    explicit bitmap_expression(const dynamic_bitset& rows) :
+        m_program{op_t{op_code::PUSH, &rows}}, m_bits{rows.size()}, m_depth{1}
+    {}
+
+    //? The expression refers to its operands, not to temporary copies
+    explicit bitmap_expression(dynamic_bitset&&) = delete;
+
+    /**
+     * @brief Count of rows
+     */
+    inline size_type size() const noexcept { return m_bits; }
+
+    friend inline bitmap_expression
+        operator&(const bitmap_expression& lhs, const bitmap_expression& rhs)
+    {
+        return binary_(lhs, rhs, op_code::AND);
+    }
+
+    friend inline bitmap_expression
+        operator|(const bitmap_expression& lhs, const bitmap_expression& rhs)
+    {
+        return binary_(lhs, rhs, op_code::OR);
+    }
+
+    friend inline bitmap_expression
+        operator^(const bitmap_expression& lhs, const bitmap_expression& rhs)
+    {
+        return binary_(lhs, rhs, op_code::XOR);
+    }
+
+    /**
+     * @brief lhs & ~rhs in one pass
+     */
+    friend inline bitmap_expression
+        and_not(const bitmap_expression& lhs, const bitmap_expression& rhs)
+    {
+        return binary_(lhs, rhs, op_code::AND_NOT);
+    }
+
+    bitmap_expression operator~() const
+    {
+        //? ~~x is x
+        if (!m_program.empty() && m_program.back().m_code == op_code::NOT)
+        {
+            bitmap_expression r_{*this};
+            r_.m_program.pop_back();
+            return r_;
+        }
+        bitmap_expression r_{*this};
+        r_.m_program.push_back(op_t{op_code::NOT, nullptr});
+        return r_;
+    }
+
+    /**
+     * @brief Rows matching the expression
+     */
+    dynamic_bitset evaluate() const
+    {
+        using namespace detail::bitmap_index;
+        dynamic_bitset r_(m_bits);
+        std::vector<word_t> stack_(m_depth * CHUNK_WORDS);
+        std::vector<const word_t*> slots_;
+        const auto words_ = storage_words(r_);
+        for (size_type begin_{0}; begin_ < words_; begin_ += CHUNK_WORDS)
+        {
+            const auto count_ = words_ - begin_ < CHUNK_WORDS ? words_ - begin_ : CHUNK_WORDS;
+            const auto* chunk_ = evaluate_chunk_(begin_, count_, stack_.data(), slots_);
+            std::memcpy(r_.data() + begin_, chunk_, count_ * sizeof(word_t));
+        }
+        clear_padding(r_);
+        return r_;
+    }
+
+    /**
+     * @brief Count of rows matching the expression (the rows are not stored)
+     */
+    size_type count() const
+    {
+        using namespace detail::bitmap_index;
+        using namespace detail::dynamic_bitset;
+        size_type r_{0};
+        std::vector<word_t> stack_(m_depth * CHUNK_WORDS);
+        std::vector<const word_t*> slots_;
+        const auto full_words_ = m_bits / BITS_IN_WORD;
+        const auto words_ = (m_bits + BITS_IN_WORD - 1) / BITS_IN_WORD;
+        const auto storage_ = (words_ + BLOCK_WORDS - 1) / BLOCK_WORDS * BLOCK_WORDS;
+        for (size_type begin_{0}; begin_ < storage_; begin_ += CHUNK_WORDS)
+        {
+            const auto count_ = storage_ - begin_ < CHUNK_WORDS ? storage_ - begin_ : CHUNK_WORDS;
+            const auto* chunk_ = evaluate_chunk_(begin_, count_, stack_.data(), slots_);
+            if (begin_ + count_ <= full_words_)
+            {
+                r_ += detail::dynamic_bitset::count<bit_op::FIRST>(chunk_, chunk_, count_);
+                continue;
+            }
+            //? The last chunk: bits past size() may be set by negation
+            size_type i_{0};
+            for (; begin_ + i_ < full_words_; ++i_)
+            {
+                r_ += detail::minimal_bitset::popcount_(chunk_[i_]);
+            }
+            if (m_bits % BITS_IN_WORD && i_ < count_)
+            {
+                r_ += detail::minimal_bitset::popcount_(
+                    chunk_[i_] & ((word_t{1} << (m_bits % BITS_IN_WORD)) - 1));
+            }
+            break;
+        }
+        return r_;
+    }
+};
+
+/**
+ * @brief Equality encoded index: one row set per distinct value
+ */
+template<class T, class Hash = std::hash<T>>
+class bitmap_index
+{
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+  private:
+    std::unordered_map<T, size_type, Hash> m_slots;
+    std::vector<dynamic_bitset> m_rows;
+    //? Row set of the values which are not in the column
+    dynamic_bitset m_none;
+
+  public:
+    /**
+     * @brief Indexes the column [first, last)
+     */
+    template<class ForwardIt>
+    bitmap_index(ForwardIt first, ForwardIt last) :
+        m_none(static_cast<size_type>(std::distance(first, last)))
+    {
+        for (size_type row_{0}; first != last; ++first, ++row_)
+        {
+            const auto it_ = m_slots.emplace(*first, m_rows.size()).first;
+            if (it_->second == m_rows.size())
+            {
+                m_rows.emplace_back(m_none.size());
+            }
+            m_rows[it_->second].set(row_);
+        }
+    }
+
+    /**
+     * @brief Count of rows
+     */
+    inline size_type size() const noexcept { return m_none.size(); }
+
+    /**
+     * @brief Count of distinct values
+     */
+    inline size_type cardinality() const noexcept { return m_rows.size(); }
+
+    /**
+     * @brief Rows equal to value (empty row set for an absent value)
+     */
+    const dynamic_bitset& rows(const T& value) const
+    {
+        const auto it_ = m_slots.find(value);
+        return it_ == m_slots.end() ? m_none : m_rows[it_->second];
+    }
+
+    inline bitmap_expression equal(const T& value) const
+    {
+        return bitmap_expression{rows(value)};
+    }
+
+    /**
+     * @brief Rows equal to any of values
+     */
+    bitmap_expression in(std::initializer_list<T> values) const
+    {
+        auto r_ = bitmap_expression{m_none};
+        for (const auto& value_ : values)
+        {
+            r_ = r_ | equal(value_);
+        }
+        return r_;
+    }
+};
+
+/**
+ * @brief Bit-sliced index of unsigned values: row set i holds bit i of the values
+ */
+template<class T>
+class bit_sliced_index
+{
+    static_assert(std::is_unsigned<T>::value, "bit_sliced_index requires unsigned values");
+
+    using word_t = detail::bitmap_index::word_t;
+
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+    static constexpr size_type SLICES = sizeof(T) * CHAR_BIT;
+
+  private:
+    std::vector<dynamic_bitset> m_slices;
+    size_type m_rows;
+
+    /**
+     * Rows less than and equal to value in words [begin, begin + count)
+     */
+    void compare_chunk_(T value, size_type begin, size_type count,
+        word_t* less, word_t* equal) const noexcept
+    {
+        for (size_type i{0}; i < count; ++i)
+        {
+            less[i] = 0;
+            equal[i] = ~word_t{0};
+        }
+        for (size_type s{SLICES}; s-- > 0;)
+        {
+            const auto* slice_ = m_slices[s].data() + begin;
+            if ((value >> s) & 1)
+            {
+                for (size_type i{0}; i < count; ++i)
+                {
+                    less[i] |= equal[i] & ~slice_[i];
+                    equal[i] &= slice_[i];
+                }
+            }
+            else
+            {
+                for (size_type i{0}; i < count; ++i)
+                {
+                    equal[i] &= ~slice_[i];
+                }
+            }
+        }
+    }
+
+    /**
+     * Rows for which f(less than lo, equal to lo, less than hi, equal to hi) is set
+     */
+    template<class F>
+    dynamic_bitset select_(T lo, T hi, F f) const
+    {
+        using namespace detail::bitmap_index;
+        dynamic_bitset r_(m_rows);
+        std::vector<word_t> buffer_(4 * CHUNK_WORDS);
+        auto* lo_less_ = buffer_.data();
+        auto* lo_equal_ = lo_less_ + CHUNK_WORDS;
+        auto* hi_less_ = lo_equal_ + CHUNK_WORDS;
+        auto* hi_equal_ = hi_less_ + CHUNK_WORDS;
+        const auto words_ = storage_words(r_);
+        for (size_type begin_{0}; begin_ < words_; begin_ += CHUNK_WORDS)
+        {
+            const auto count_ = words_ - begin_ < CHUNK_WORDS ? words_ - begin_ : CHUNK_WORDS;
+            compare_chunk_(lo, begin_, count_, lo_less_, lo_equal_);
+            if (hi != lo)
+            {
+                compare_chunk_(hi, begin_, count_, hi_less_, hi_equal_);
+            }
+            else
+            {
+                std::memcpy(hi_less_, lo_less_, count_ * sizeof(word_t));
+                std::memcpy(hi_equal_, lo_equal_, count_ * sizeof(word_t));
+            }
+            auto* dst_ = r_.data() + begin_;
+            for (size_type i{0}; i < count_; ++i)
+            {
+                dst_[i] = f(lo_less_[i], lo_equal_[i], hi_less_[i], hi_equal_[i]);
+            }
+        }
+        clear_padding(r_);
+        return r_;
+    }
+
+  public:
+    /**
+     * @brief Indexes the column [first, last)
+     */
+    template<class ForwardIt>
+    bit_sliced_index(ForwardIt first, ForwardIt last) :
+        m_rows{static_cast<size_type>(std::distance(first, last))}
+    {
+        m_slices.reserve(SLICES);
+        for (size_type s{0}; s < SLICES; ++s)
+        {
+            m_slices.emplace_back(m_rows);
+        }
+        for (size_type row_{0}; first != last; ++first, ++row_)
+        {
+            for (auto value_ = static_cast<T>(*first); value_; value_ &= value_ - 1)
+            {
+                m_slices[detail::minimal_bitset::lowest_bit_(value_)].set(row_);
+            }
+        }
+    }
+
+    /**
+     * @brief Count of rows
+     */
+    inline size_type size() const noexcept { return m_rows; }
+
+    /**
+     * @brief Row set of bit slice (slice < SLICES)
+     */
+    inline const dynamic_bitset& slice(size_type slice) const noexcept { return m_slices[slice]; }
+
+    dynamic_bitset equal(T value) const
+    {
+        return select_(value, value, [](word_t, word_t eq, word_t, word_t) { return eq; });
+    }
+
+    dynamic_bitset less(T value) const
+    {
+        return select_(value, value, [](word_t lt, word_t, word_t, word_t) { return lt; });
+    }
+
+    dynamic_bitset less_equal(T value) const
+    {
+        return select_(value, value, [](word_t lt, word_t eq, word_t, word_t) { return lt | eq; });
+    }
+
+    dynamic_bitset greater(T value) const
+    {
+        return select_(value, value, [](word_t lt, word_t eq, word_t, word_t) { return ~(lt | eq); });
+    }
+
+    dynamic_bitset greater_equal(T value) const
+    {
+        return select_(value, value, [](word_t lt, word_t, word_t, word_t) { return ~lt; });
+    }
+
+    /**
+     * @brief Rows with lo <= value <= hi
+     */
+    dynamic_bitset between(T lo, T hi) const
+    {
+        return select_(lo, hi, [](word_t lo_lt, word_t, word_t hi_lt, word_t hi_eq)
+        {
+            return ~lo_lt & (hi_lt | hi_eq);
+        });
+    }
+
+    /**
+     * @brief Sum of the values of rows (a row set of size())
+     */
+    std::uint64_t sum(const dynamic_bitset& rows) const noexcept
+    {
+        std::uint64_t r_{0};
+        for (size_type s{0}; s < SLICES; ++s)
+        {
+            r_ += static_cast<std::uint64_t>(count_and(m_slices[s], rows)) << s;
+        }
+        return r_;
+    }
+};
+
+} // namespace containers
+
+using bitmap_expression_t = containers::bitmap_expression;
+
+template<class T, class Hash = std::hash<T>>
+using bitmap_index_t = containers::bitmap_index<T, Hash>;
+
+template<class T>
+using bit_sliced_index_t = containers::bit_sliced_index<T>;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_BITMAP_INDEX_HPP_ */
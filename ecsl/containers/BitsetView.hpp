@@ -0,0 +1,586 @@
+#ifndef ECSL_CONTAINERS_BITSET_VIEW_HPP_
+#define ECSL_CONTAINERS_BITSET_VIEW_HPP_
+
+/**
+ * @file BitsetView.hpp
+ * Declares non-owning bit vectors over external bytes (a.e. memory mapped
+ * files or network buffers)
+ *
+ * Bit order is little-endian on every platform, the same as the byte
+ * constructors of minimal_bitset: bit i is bit i % 8 of byte i / 8.
+ * The bytes need no alignment, they are processed as 64-bit little-endian
+ * words assembled from bytes (a single load on little-endian targets).
+ * Bits past size() in the last byte are neither read nor written.
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+/// ECSL
+#include <ecsl/containers/MinimalBitset.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace bitset_view {
+
+using word_t = std::uint64_t;
+
+constexpr std::size_t BYTES_IN_WORD = sizeof(word_t);
+
+/**
+ * Reads count (at most 8) bytes as a little-endian word
+ */
+inline word_t load(const types::memory_t* src, std::size_t count) noexcept
+{
+    word_t r_{0};
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        r_ |= static_cast<word_t>(src[i]) << (CHAR_BIT * i);
+    }
+    return r_;
+}
+
+inline word_t load(const types::memory_t* src) noexcept
+{
+    return load(src, BYTES_IN_WORD);
+}
+
+inline void store(types::memory_t* dst, word_t value, std::size_t count) noexcept
+{
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        dst[i] = static_cast<types::memory_t>(value >> (CHAR_BIT * i));
+    }
+}
+
+} // namespace bitset_view
+} // namespace detail
+
+/**
+ * @brief View of size() bits of external bytes
+ * @tparam Byte const types::memory_t for read-only view, types::memory_t
+ *         for mutable one
+ */
+template<class Byte>
+class basic_bitset_view
+{
+    static_assert(std::is_same<typename std::remove_const<Byte>::type, types::memory_t>::value,
+        "basic_bitset_view requires (const) types::memory_t bytes");
+
+    using word_t = detail::bitset_view::word_t;
+
+    static constexpr bool IS_MUTABLE = !std::is_const<Byte>::value;
+
+    template<class>
+    friend class basic_bitset_view;
+
+  public:
+    using size_type     = std::size_t;
+    using byte_type     = Byte;
+    using reference     = typename std::conditional<IS_MUTABLE,
+        detail::minimal_bitset::bit_reference<types::memory_t>, bool>::type;
+
+    static constexpr size_type BITS_IN_BYTE = CHAR_BIT;
+    static constexpr size_type BITS_IN_WORD = sizeof(word_t) * CHAR_BIT;
+
+  private:
+    Byte* m_data;
+    size_type m_bits;
+
+    inline size_type byte_count_() const noexcept
+    {
+        return (m_bits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+    }
+
+    inline size_type word_count_() const noexcept
+    {
+        return (m_bits + BITS_IN_WORD - 1) / BITS_IN_WORD;
+    }
+
+    /**
+     * Bytes of the word (less than 8 for the last word)
+     */
+    inline size_type word_bytes_(size_type word) const noexcept
+    {
+        const auto left_ = byte_count_() - word * detail::bitset_view::BYTES_IN_WORD;
+        return left_ < detail::bitset_view::BYTES_IN_WORD ? left_ : detail::bitset_view::BYTES_IN_WORD;
+    }
+
+    /**
+     * Bits of the word which belong to the view
+     */
+    inline word_t word_mask_(size_type word) const noexcept
+    {
+        return word + 1 == word_count_() && m_bits % BITS_IN_WORD ?
+            (word_t{1} << (m_bits % BITS_IN_WORD)) - 1 : ~word_t{0};
+    }
+
+    inline word_t load_(size_type word) const noexcept
+    {
+        const auto* src_ = m_data + word * detail::bitset_view::BYTES_IN_WORD;
+        return (word + 1 < word_count_() ? detail::bitset_view::load(src_) :
+            detail::bitset_view::load(src_, word_bytes_(word))) & word_mask_(word);
+    }
+
+    /**
+     * Writes the bits of the view in the word, foreign bits of the last byte are kept
+     */
+    inline void store_(size_type word, word_t value) const noexcept
+    {
+        auto* dst_ = m_data + word * detail::bitset_view::BYTES_IN_WORD;
+        if (word + 1 < word_count_())
+        {
+            return detail::bitset_view::store(dst_, value, detail::bitset_view::BYTES_IN_WORD);
+        }
+        const auto bytes_ = word_bytes_(word);
+        const auto mask_ = word_mask_(word);
+        const auto old_ = detail::bitset_view::load(dst_, bytes_);
+        detail::bitset_view::store(dst_, (old_ & ~mask_) | (value & mask_), bytes_);
+    }
+
+    template<bool ZERO>
+    inline word_t search_word_(size_type word) const noexcept
+    {
+        return ZERO ? ~load_(word) & word_mask_(word) : load_(word);
+    }
+
+    /**
+     * Position of the first set (zero) bit at or after position or size()
+     */
+    template<bool ZERO>
+    size_type find_from_(size_type position) const noexcept
+    {
+        if (position >= m_bits)
+        {
+            return m_bits;
+        }
+        auto word_ = position / BITS_IN_WORD;
+        auto bits_ = search_word_<ZERO>(word_) & (~word_t{0} << (position % BITS_IN_WORD));
+        while (!bits_)
+        {
+            if (++word_ == word_count_())
+            {
+                return m_bits;
+            }
+            bits_ = search_word_<ZERO>(word_);
+        }
+        return word_ * BITS_IN_WORD + detail::minimal_bitset::lowest_bit_(bits_);
+    }
+
+    template<bool ZERO>
+    size_type find_last_() const noexcept
+    {
+        for (auto i = word_count_(); i-- > 0;)
+        {
+            if (const auto bits_ = search_word_<ZERO>(i))
+            {
+                return i * BITS_IN_WORD + detail::minimal_bitset::highest_bit_(bits_);
+            }
+        }
+        return m_bits;
+    }
+
+    /**
+     * this[i] = f(this[i], other[i]), missing bits of other are zeros
+     */
+    template<class Other, class F>
+    void swipe_(const basic_bitset_view<Other>& other, F f) const noexcept
+    {
+        const auto other_words_ = other.word_count_();
+        for (size_type i{0}; i < word_count_(); ++i)
+        {
+            store_(i, f(load_(i), i < other_words_ ? other.load_(i) : word_t{0}));
+        }
+    }
+
+    template<bool MUTABLE>
+    using if_mutable_ = typename std::enable_if<MUTABLE && IS_MUTABLE, int>::type;
+
+  public:
+    template<bool ZERO>
+    class index_iterator
+    {
+        friend class basic_bitset_view;
+
+      public:
+        using value_type        = std::size_t;
+        using pointer           = const value_type*;
+        using reference         = value_type;
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+
+      private:
+        index_iterator(const basic_bitset_view* view, value_type bit) noexcept :
+            m_view{view}, m_bit{bit}
+        {}
+
+      public:
+        index_iterator() noexcept : m_view{nullptr}, m_bit{0} {}
+
+        reference operator*() const noexcept { return m_bit; }
+
+        index_iterator& operator++() noexcept
+        {
+            m_bit = m_view->template find_from_<ZERO>(m_bit + 1);
+            return *this;
+        }
+        index_iterator operator++(int) noexcept
+        {
+            index_iterator old{*this};
+            ++(*this);
+            return old;
+        }
+
+        friend bool operator==(const index_iterator& lhs, const index_iterator& rhs) noexcept
+        {   //? This operation must not be defined for different views
+            return lhs.m_bit == rhs.m_bit;
+        }
+        friend bool operator!=(const index_iterator& lhs, const index_iterator& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+      private:
+        const basic_bitset_view* m_view;
+        value_type m_bit;
+    };
+
+    template<bool ZERO>
+    class index_range
+    {
+        friend class basic_bitset_view;
+
+        explicit index_range(const basic_bitset_view* view) noexcept : m_view{view} {}
+
+      public:
+        using iterator = index_iterator<ZERO>;
+
+        iterator begin() const noexcept
+        {
+            return {m_view, m_view->template find_from_<ZERO>(0)};
+        }
+        iterator end() const noexcept
+        {
+            return {m_view, m_view->m_bits};
+        }
+
+      private:
+        const basic_bitset_view* m_view;
+    };
+
+    basic_bitset_view() noexcept : m_data{nullptr}, m_bits{0} {}
+
+    /**
+     * @brief View of bits [0, bits) of data (ceil(bits / 8) bytes)
+     */
+    basic_bitset_view(Byte* data, size_type bits) noexcept : m_data{data}, m_bits{bits} {}
+
+    /**
+     * @brief Read-only view of a mutable one
+     */
+    template<class Other, class = typename std::enable_if<
+        !IS_MUTABLE && !std::is_const<Other>::value>::type>
+    basic_bitset_view(const basic_bitset_view<Other>& other) noexcept :
+        m_data{other.m_data}, m_bits{other.m_bits}
+    {}
+
+    inline size_type size() const noexcept { return m_bits; }
+    inline bool empty() const noexcept { return m_bits == 0; }
+    inline Byte* data() const noexcept { return m_data; }
+
+    /**
+     * @brief Count of bytes holding size() bits
+     */
+    inline size_type size_bytes() const noexcept { return byte_count_(); }
+
+    /* Single bit access */
+
+    inline bool test(size_type position) const noexcept
+    {
+        return position < m_bits &&
+            ((m_data[position / BITS_IN_BYTE] >> (position % BITS_IN_BYTE)) & 1);
+    }
+
+    /**
+     * @brief Bit value (bool) or reference to the bit of mutable view
+     */
+    inline reference operator[](size_type position) const noexcept
+    {
+        return reference_(position, std::integral_constant<bool, IS_MUTABLE>{});
+    }
+
+    reference at(size_type position) const
+    {
+        if (position < m_bits)
+        {
+            return operator[](position);
+        }
+        throw std::out_of_range{"bitset_view range check failed"};
+    }
+
+  private:
+    inline reference reference_(size_type position, std::true_type) const noexcept
+    {
+        return {m_data + position / BITS_IN_BYTE,
+            static_cast<types::length_t>(position % BITS_IN_BYTE)};
+    }
+
+    inline reference reference_(size_type position, std::false_type) const noexcept
+    {
+        return (m_data[position / BITS_IN_BYTE] >> (position % BITS_IN_BYTE)) & 1;
+    }
+
+  public:
+    /* Modifiers of mutable view: out of range positions are ignored */
+
+    template<bool M = true, if_mutable_<M> = 0>
+    void set(size_type position, bool value = true) const noexcept
+    {
+        if (position < m_bits)
+        {
+            const auto mask_ = static_cast<types::memory_t>(1u << (position % BITS_IN_BYTE));
+            auto& byte_ = m_data[position / BITS_IN_BYTE];
+            byte_ = static_cast<types::memory_t>(value ? byte_ | mask_ : byte_ & ~mask_);
+        }
+    }
+
+    template<bool M = true, if_mutable_<M> = 0>
+    inline void reset(size_type position) const noexcept
+    {
+        set(position, false);
+    }
+
+    template<bool M = true, if_mutable_<M> = 0>
+    void flip(size_type position) const noexcept
+    {
+        if (position < m_bits)
+        {
+            m_data[position / BITS_IN_BYTE] = static_cast<types::memory_t>(
+                m_data[position / BITS_IN_BYTE] ^ (1u << (position % BITS_IN_BYTE)));
+        }
+    }
+
+    template<bool M = true, if_mutable_<M> = 0>
+    void set() const noexcept
+    {
+        for (size_type i{0}; i < word_count_(); ++i)
+        {
+            store_(i, ~word_t{0});
+        }
+    }
+
+    template<bool M = true, if_mutable_<M> = 0>
+    void reset() const noexcept
+    {
+        for (size_type i{0}; i < word_count_(); ++i)
+        {
+            store_(i, 0);
+        }
+    }
+
+    template<bool M = true, if_mutable_<M> = 0>
+    void flip() const noexcept
+    {
+        for (size_type i{0}; i < word_count_(); ++i)
+        {
+            store_(i, ~load_(i));
+        }
+    }
+
+    /* Bulk operations with views of any size: missing bits are zeros */
+
+    template<class Other, bool M = true, if_mutable_<M> = 0>
+    const basic_bitset_view& operator&=(const basic_bitset_view<Other>& other) const noexcept
+    {
+        swipe_(other, [](word_t a, word_t b) { return a & b; });
+        return *this;
+    }
+
+    template<class Other, bool M = true, if_mutable_<M> = 0>
+    const basic_bitset_view& operator|=(const basic_bitset_view<Other>& other) const noexcept
+    {
+        swipe_(other, [](word_t a, word_t b) { return a | b; });
+        return *this;
+    }
+
+    template<class Other, bool M = true, if_mutable_<M> = 0>
+    const basic_bitset_view& operator^=(const basic_bitset_view<Other>& other) const noexcept
+    {
+        swipe_(other, [](word_t a, word_t b) { return a ^ b; });
+        return *this;
+    }
+
+    /**
+     * @brief this &= ~other
+     */
+    template<class Other, bool M = true, if_mutable_<M> = 0>
+    const basic_bitset_view& and_not(const basic_bitset_view<Other>& other) const noexcept
+    {
+        swipe_(other, [](word_t a, word_t b) { return a & ~b; });
+        return *this;
+    }
+
+    /**
+     * @brief Copies the bits of other (missing bits are zeros)
+     */
+    template<class Other, bool M = true, if_mutable_<M> = 0>
+    const basic_bitset_view& assign(const basic_bitset_view<Other>& other) const noexcept
+    {
+        swipe_(other, [](word_t, word_t b) { return b; });
+        return *this;
+    }
+
+    /* Queries */
+
+    size_type count() const noexcept
+    {
+        size_type r_{0};
+        for (size_type i{0}; i < word_count_(); ++i)
+        {
+            r_ += detail::minimal_bitset::popcount_(load_(i));
+        }
+        return r_;
+    }
+
+    bool any() const noexcept
+    {
+        for (size_type i{0}; i < word_count_(); ++i)
+        {
+            if (load_(i))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline bool none() const noexcept { return !any(); }
+
+    bool all() const noexcept
+    {
+        for (size_type i{0}; i < word_count_(); ++i)
+        {
+            if (load_(i) != word_mask_(i))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Search: positions are returned as size_type, size() if not found */
+
+    inline size_type find_first() const noexcept { return find_from_<false>(0); }
+
+    inline size_type find_next(size_type position) const noexcept
+    {
+        return position < m_bits ? find_from_<false>(position + 1) : m_bits;
+    }
+
+    inline size_type find_last() const noexcept { return find_last_<false>(); }
+
+    inline size_type find_first_zero() const noexcept { return find_from_<true>(0); }
+
+    inline size_type find_next_zero(size_type position) const noexcept
+    {
+        return position < m_bits ? find_from_<true>(position + 1) : m_bits;
+    }
+
+    inline size_type find_last_zero() const noexcept { return find_last_<true>(); }
+
+    /**
+     * @brief Range of set bit positions in ascending order
+     */
+    inline index_range<false> set_bits() const noexcept { return index_range<false>{this}; }
+
+    /**
+     * @brief Range of zero bit positions in ascending order
+     */
+    inline index_range<true> zero_bits() const noexcept { return index_range<true>{this}; }
+
+    /* Fused binary queries: missing bits are zeros */
+
+    template<class Other>
+    friend size_type count_and(const basic_bitset_view& a, const basic_bitset_view<Other>& b) noexcept
+    {
+        return a.count_and_(b);
+    }
+
+    template<class Other>
+    friend bool intersects(const basic_bitset_view& a, const basic_bitset_view<Other>& b) noexcept
+    {
+        return a.intersects_(b);
+    }
+
+    template<class Other>
+    friend bool operator==(const basic_bitset_view& lhs, const basic_bitset_view<Other>& rhs) noexcept
+    {
+        return lhs.equal_(rhs);
+    }
+
+    template<class Other>
+    friend bool operator!=(const basic_bitset_view& lhs, const basic_bitset_view<Other>& rhs) noexcept
+    {
+        return !lhs.equal_(rhs);
+    }
+
+  private:
+    template<class Other>
+    size_type count_and_(const basic_bitset_view<Other>& other) const noexcept
+    {
+        size_type r_{0};
+        const auto words_ = word_count_() < other.word_count_() ? word_count_() : other.word_count_();
+        for (size_type i{0}; i < words_; ++i)
+        {
+            r_ += detail::minimal_bitset::popcount_(load_(i) & other.load_(i));
+        }
+        return r_;
+    }
+
+    template<class Other>
+    bool intersects_(const basic_bitset_view<Other>& other) const noexcept
+    {
+        const auto words_ = word_count_() < other.word_count_() ? word_count_() : other.word_count_();
+        for (size_type i{0}; i < words_; ++i)
+        {
+            if (load_(i) & other.load_(i))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<class Other>
+    bool equal_(const basic_bitset_view<Other>& other) const noexcept
+    {
+        if (m_bits != other.m_bits)
+        {
+            return false;
+        }
+        for (size_type i{0}; i < word_count_(); ++i)
+        {
+            if (load_(i) != other.load_(i))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+using bitset_view = basic_bitset_view<const types::memory_t>;
+using mutable_bitset_view = basic_bitset_view<types::memory_t>;
+
+} // namespace containers
+
+using bitset_view_t = containers::bitset_view;
+using mutable_bitset_view_t = containers::mutable_bitset_view;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_BITSET_VIEW_HPP_ */
@@ -0,0 +1,440 @@
+#ifndef ECSL_CONTAINERS_BLOOM_FILTER_HPP_
+#define ECSL_CONTAINERS_BLOOM_FILTER_HPP_
+
+/**
+ * @file BloomFilter.hpp
+ * Declares cache line blocked Bloom filter
+ *
+ * The bits are a dynamic_bitset split into 512-bit blocks (one 64-byte
+ * cache line, the bitset storage is 64-byte aligned). A key sets K = 8
+ * bits in one block, one bit in every 64-bit word of it, so a query reads
+ * exactly one cache line: the block index comes from the high half of the
+ * hash, the 8 bit positions from the low half multiplied by 8 odd salts
+ * (one vpmulld). The 8 bits are tested at once: one vptestmq with
+ * AVX-512, two vptest with AVX2 (run time dispatch), a word loop otherwise.
+ *
+ * False positive rate is about 3% at 8 bits per key, 1% at 10 and 0.4%
+ * at 12 (a bit worse than a classic Bloom filter of the same size, which
+ * reads up to K cache lines per query).
+ *
+ * Serialized form (little-endian): u32 magic "ECBF", u32 block count,
+ * then 8 u64 words of every block.
+ *
+ * Sources:
+ *  F. Putze, P. Sanders, J. Singler "Cache-, Hash- and Space-Efficient
+ *  Bloom Filters" WEA 2007
+ *  Apache Parquet "Split Block Bloom Filter" specification (salts)
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+/// ECSL
+#include <ecsl/containers/DynamicBitset.hpp>
+#include <ecsl/platform/CpuFeatures.hpp>
+#include <ecsl/platform/Simd.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace bloom_filter {
+
+using word_t = std::uint64_t;
+
+constexpr std::size_t BLOCK_WORDS = 8;
+constexpr std::size_t BLOCK_BITS = BLOCK_WORDS * sizeof(word_t) * CHAR_BIT;
+//? Bit index in a word is the top 6 bits of the 32-bit product
+constexpr unsigned SHIFT = 32 - 6;
+
+struct tables
+{
+    alignas(32) static constexpr std::uint32_t SALT[BLOCK_WORDS] = {
+        0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+        0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u,
+    };
+};
+
+/**
+ * Murmur3 finalizer: hashes of std::hash may be the identity
+ */
+constexpr std::uint64_t mix(std::uint64_t h) noexcept
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+inline void insert_scalar_(word_t* block, std::uint32_t h) noexcept
+{
+    for (std::size_t i{0}; i < BLOCK_WORDS; ++i)
+    {
+        block[i] |= word_t{1} << (static_cast<std::uint32_t>(h * tables::SALT[i]) >> SHIFT);
+    }
+}
+
+inline bool contains_scalar_(const word_t* block, std::uint32_t h) noexcept
+{
+    word_t r_{1};
+    for (std::size_t i{0}; i < BLOCK_WORDS; ++i)
+    {
+        r_ &= block[i] >> (static_cast<std::uint32_t>(h * tables::SALT[i]) >> SHIFT);
+    }
+    return r_ & 1;
+}
+
+#if defined(ECSL_SIMD_DISPATCH)
+
+ECSL_SIMD_TARGET("avx2")
+inline __m256i bit_indices_avx2_(std::uint32_t h) noexcept
+{
+    const __m256i salt_ = _mm256_load_si256(reinterpret_cast<const __m256i*>(tables::SALT));
+    return _mm256_srli_epi32(_mm256_mullo_epi32(
+        _mm256_set1_epi32(static_cast<int>(h)), salt_), SHIFT);
+}
+
+ECSL_SIMD_TARGET("avx2")
+inline void masks_avx2_(std::uint32_t h, __m256i& low, __m256i& high) noexcept
+{
+    const __m256i indices_ = bit_indices_avx2_(h);
+    const __m256i one_ = _mm256_set1_epi64x(1);
+    low = _mm256_sllv_epi64(one_, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(indices_)));
+    high = _mm256_sllv_epi64(one_, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(indices_, 1)));
+}
+
+ECSL_SIMD_TARGET("avx2")
+inline void insert_avx2_(word_t* block, std::uint32_t h) noexcept
+{
+    __m256i low_, high_;
+    masks_avx2_(h, low_, high_);
+    auto* dst_ = reinterpret_cast<__m256i*>(block);
+    _mm256_store_si256(dst_, _mm256_or_si256(_mm256_load_si256(dst_), low_));
+    _mm256_store_si256(dst_ + 1, _mm256_or_si256(_mm256_load_si256(dst_ + 1), high_));
+}
+
+ECSL_SIMD_TARGET("avx2")
+inline bool contains_avx2_(const word_t* block, std::uint32_t h) noexcept
+{
+    __m256i low_, high_;
+    masks_avx2_(h, low_, high_);
+    const auto* src_ = reinterpret_cast<const __m256i*>(block);
+    //? testc: (~block & mask) == 0
+    return _mm256_testc_si256(_mm256_load_si256(src_), low_) &
+        _mm256_testc_si256(_mm256_load_si256(src_ + 1), high_);
+}
+
+ECSL_SIMD_TARGET("avx512f,avx2")
+inline __m512i mask_avx512_(std::uint32_t h) noexcept
+{
+    //? maskz forms: the plain ones trip -Wuninitialized in GCC 12 headers
+    return _mm512_maskz_sllv_epi64(0xFF, _mm512_set1_epi64(1),
+        _mm512_maskz_cvtepu32_epi64(0xFF, bit_indices_avx2_(h)));
+}
+
+ECSL_SIMD_TARGET("avx512f,avx2")
+inline void insert_avx512_(word_t* block, std::uint32_t h) noexcept
+{
+    _mm512_store_si512(block, _mm512_or_si512(_mm512_load_si512(block), mask_avx512_(h)));
+}
+
+ECSL_SIMD_TARGET("avx512f,avx2")
+inline bool contains_avx512_(const word_t* block, std::uint32_t h) noexcept
+{
+    //? Every lane of the mask has one bit: test is non zero in all 8 lanes
+    return _mm512_test_epi64_mask(_mm512_load_si512(block), mask_avx512_(h)) == 0xFF;
+}
+
+#endif /* ECSL_SIMD_DISPATCH */
+
+inline void insert(word_t* block, std::uint32_t h) noexcept
+{
+#if defined(ECSL_SIMD_DISPATCH)
+    const auto& cpu_ = runtime_cpu_features();
+    if (cpu_.avx512f)
+    {
+        return insert_avx512_(block, h);
+    }
+    if (cpu_.avx2)
+    {
+        return insert_avx2_(block, h);
+    }
+#endif
+    insert_scalar_(block, h);
+}
+
+inline bool contains(const word_t* block, std::uint32_t h) noexcept
+{
+#if defined(ECSL_SIMD_DISPATCH)
+    const auto& cpu_ = runtime_cpu_features();
+    if (cpu_.avx512f)
+    {
+        return contains_avx512_(block, h);
+    }
+    if (cpu_.avx2)
+    {
+        return contains_avx2_(block, h);
+    }
+#endif
+    return contains_scalar_(block, h);
+}
+
+inline void prefetch(const void* address) noexcept
+{
+#if defined(ECSL_COMPILER_GCC) || defined(ECSL_COMPILER_CLANG)
+    __builtin_prefetch(address);
+#elif defined(ECSL_SIMD_X86)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+constexpr std::uint32_t MAGIC = 0x46424345; //? "ECBF" in little-endian
+constexpr std::size_t HEADER_SIZE = 8;
+
+} // namespace bloom_filter
+} // namespace detail
+
+/**
+ * @brief Bloom filter reading one cache line per query
+ */
+class blocked_bloom_filter
+{
+  public:
+    using word_type     = std::uint64_t;
+    using size_type     = std::size_t;
+
+    static constexpr size_type BLOCK_BITS = detail::bloom_filter::BLOCK_BITS;
+    static constexpr size_type HASHES = detail::bloom_filter::BLOCK_WORDS;
+
+  private:
+    //? Count of queries with computed blocks before the first test in bulk operations
+    static constexpr size_type BATCH = 16;
+
+    dynamic_bitset m_bits;
+    size_type m_blocks;
+
+    /**
+     * Block of the mixed hash (multiply-shift instead of modulo)
+     */
+    inline size_type block_index_(std::uint64_t h) const noexcept
+    {
+        return static_cast<size_type>(((h >> 32) * m_blocks) >> 32);
+    }
+
+    inline word_type* block_(std::uint64_t h) noexcept
+    {
+        return m_bits.data() + block_index_(h) * HASHES;
+    }
+
+    inline const word_type* block_(std::uint64_t h) const noexcept
+    {
+        return m_bits.data() + block_index_(h) * HASHES;
+    }
+
+  public:
+    /**
+     * @brief Filter of at least bits bits (rounded up to whole blocks)
+     * 10 bits per expected key give about 1% false positives.
+     */
+    explicit blocked_bloom_filter(size_type bits) :
+        m_bits{}, m_blocks{(bits + BLOCK_BITS - 1) / BLOCK_BITS}
+    {
+        m_blocks = m_blocks ? m_blocks : 1;
+        if (m_blocks > 0xFFFFFFFFu)
+        {
+            throw std::out_of_range{"blocked_bloom_filter range check failed"};
+        }
+        m_bits.resize(m_blocks * BLOCK_BITS);
+    }
+
+    inline size_type size() const noexcept { return m_bits.size(); }
+    inline size_type block_count() const noexcept { return m_blocks; }
+
+    /**
+     * @brief Count of set bits divided by size() (0.5 is the optimal load)
+     */
+    inline double fill_ratio() const noexcept
+    {
+        return static_cast<double>(m_bits.count()) / static_cast<double>(m_bits.size());
+    }
+
+    void clear() noexcept
+    {
+        m_bits.reset();
+    }
+
+    /* Hash interface: hashes are mixed, so weak hashes are acceptable */
+
+    inline void insert_hash(std::uint64_t hash) noexcept
+    {
+        const auto h_ = detail::bloom_filter::mix(hash);
+        detail::bloom_filter::insert(block_(h_), static_cast<std::uint32_t>(h_));
+    }
+
+    inline bool contains_hash(std::uint64_t hash) const noexcept
+    {
+        const auto h_ = detail::bloom_filter::mix(hash);
+        return detail::bloom_filter::contains(block_(h_), static_cast<std::uint32_t>(h_));
+    }
+
+    /**
+     * @brief Inserts count hashes, the blocks are prefetched in batches
+     */
+    void insert_hashes(const std::uint64_t* hashes, size_type count) noexcept
+    {
+        std::uint64_t h_[BATCH];
+        for (size_type i{0}; i < count; i += BATCH)
+        {
+            const auto n_ = count - i < BATCH ? count - i : BATCH;
+            for (size_type j{0}; j < n_; ++j)
+            {
+                h_[j] = detail::bloom_filter::mix(hashes[i + j]);
+                detail::bloom_filter::prefetch(block_(h_[j]));
+            }
+            for (size_type j{0}; j < n_; ++j)
+            {
+                detail::bloom_filter::insert(block_(h_[j]), static_cast<std::uint32_t>(h_[j]));
+            }
+        }
+    }
+
+    /**
+     * @brief Queries count hashes, the blocks are prefetched in batches
+     * @return Count of positive answers
+     */
+    size_type contains_hashes(const std::uint64_t* hashes, size_type count, bool* result) const noexcept
+    {
+        size_type r_{0};
+        std::uint64_t h_[BATCH];
+        for (size_type i{0}; i < count; i += BATCH)
+        {
+            const auto n_ = count - i < BATCH ? count - i : BATCH;
+            for (size_type j{0}; j < n_; ++j)
+            {
+                h_[j] = detail::bloom_filter::mix(hashes[i + j]);
+                detail::bloom_filter::prefetch(block_(h_[j]));
+            }
+            for (size_type j{0}; j < n_; ++j)
+            {
+                result[i + j] = detail::bloom_filter::contains(
+                    block_(h_[j]), static_cast<std::uint32_t>(h_[j]));
+                r_ += result[i + j];
+            }
+        }
+        return r_;
+    }
+
+    /* Key interface */
+
+    template<class Key, class Hash = std::hash<Key>>
+    inline void insert(const Key& key, const Hash& hash = Hash{})
+    {
+        insert_hash(static_cast<std::uint64_t>(hash(key)));
+    }
+
+    template<class Key, class Hash = std::hash<Key>>
+    inline bool contains(const Key& key, const Hash& hash = Hash{}) const
+    {
+        return contains_hash(static_cast<std::uint64_t>(hash(key)));
+    }
+
+    /**
+     * @brief Union with a filter of the same size (inserted keys of both)
+     */
+    blocked_bloom_filter& operator|=(const blocked_bloom_filter& other)
+    {
+        if (other.m_blocks != m_blocks)
+        {
+            throw std::out_of_range{"blocked_bloom_filter range check failed"};
+        }
+        m_bits |= other.m_bits;
+        return *this;
+    }
+
+    friend inline bool
+        operator==(const blocked_bloom_filter& lhs, const blocked_bloom_filter& rhs) noexcept
+    {
+        return lhs.m_bits == rhs.m_bits;
+    }
+    friend inline bool
+        operator!=(const blocked_bloom_filter& lhs, const blocked_bloom_filter& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /* Serialization */
+
+    inline size_type serialized_size() const noexcept
+    {
+        return detail::bloom_filter::HEADER_SIZE + m_blocks * BLOCK_BITS / CHAR_BIT;
+    }
+
+    /**
+     * @brief Writes serialized_size() bytes to dst
+     * @return Count of bytes written
+     */
+    size_type serialize(types::memory_t* dst) const noexcept
+    {
+        using namespace detail::bloom_filter;
+        auto store_ = [&dst](std::uint64_t value, size_type bytes)
+        {
+            for (size_type i{0}; i < bytes; ++i)
+            {
+                *dst++ = static_cast<types::memory_t>(value >> (CHAR_BIT * i));
+            }
+        };
+        store_(MAGIC, 4);
+        store_(m_blocks, 4);
+        for (size_type i{0}; i < m_blocks * HASHES; ++i)
+        {
+            store_(m_bits.data()[i], sizeof(word_type));
+        }
+        return serialized_size();
+    }
+
+    /**
+     * @throw std::invalid_argument if src is not a serialized filter
+     */
+    static blocked_bloom_filter deserialize(const types::memory_t* src, size_type size)
+    {
+        using namespace detail::bloom_filter;
+        auto load_ = [&src](size_type bytes)
+        {
+            std::uint64_t r_{0};
+            for (size_type i{0}; i < bytes; ++i)
+            {
+                r_ |= static_cast<std::uint64_t>(*src++) << (CHAR_BIT * i);
+            }
+            return r_;
+        };
+        if (size < HEADER_SIZE || load_(4) != MAGIC)
+        {
+            throw std::invalid_argument{"blocked_bloom_filter malformed data"};
+        }
+        const auto blocks_ = static_cast<size_type>(load_(4));
+        if (!blocks_ || (size - HEADER_SIZE) / (BLOCK_BITS / CHAR_BIT) != blocks_ ||
+            (size - HEADER_SIZE) % (BLOCK_BITS / CHAR_BIT))
+        {
+            throw std::invalid_argument{"blocked_bloom_filter malformed data"};
+        }
+        blocked_bloom_filter r_{blocks_ * BLOCK_BITS};
+        for (size_type i{0}; i < blocks_ * HASHES; ++i)
+        {
+            r_.m_bits.data()[i] = load_(sizeof(word_type));
+        }
+        return r_;
+    }
+};
+
+} // namespace containers
+
+using blocked_bloom_filter_t = containers::blocked_bloom_filter;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_BLOOM_FILTER_HPP_ */
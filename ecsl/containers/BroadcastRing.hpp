@@ -0,0 +1,357 @@
+#ifndef ECSL_CONTAINERS_BROADCAST_RING_HPP_
+#define ECSL_CONTAINERS_BROADCAST_RING_HPP_
+
+/**
+ * @file BroadcastRing.hpp
+ * Declares bounded lock-free single producer multi consumer broadcast ring
+ *
+ * Every consumer sees every event (disruptor pattern): the producer
+ * publishes into preallocated slots by moving the cursor, each consumer
+ * moves its own sequence after it processed events, so fan-out to N
+ * consumers costs one write and N reads of an event instead of N copies.
+ * A consumer may depend on other consumers (sequence barrier) and reads
+ * only events all of them already processed, this builds pipelines:
+ *  auto& journal = ring.add_consumer();
+ *  auto& decode  = ring.add_consumer();
+ *  auto& trade   = ring.add_consumer({&journal, &decode}); //? after both
+ * The producer waits only for consumers no other consumer depends on.
+ * Sequences are monotonic counters, each on its own cache line, and both
+ * sides reread the shared counters only when their cached values are not
+ * enough, so claim/publish and poll work in batches.
+ *
+ * Sources:
+ *  M. Thompson, D. Farley, M. Barker, P. Gee, A. Stewart "Disruptor: High
+ *  performance alternative to bounded queues for exchanging data between
+ *  concurrent threads"
+ *  https://lmax-exchange.github.io/disruptor/disruptor.html
+ */
+
+/// STD
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+/// ECSL
+#include <ecsl/containers/SpscRing.hpp>
+#include <ecsl/containers/detail/Concurrency.hpp>
+
+namespace ecsl {
+namespace containers {
+
+/**
+ * @brief Bounded broadcast queue for one producer thread and any count of
+ * consumer threads, one per consumer object. Slots hold default
+ * constructed events that the producer overwrites.
+ * Producer side: claim, publish, try_push, push_n.
+ * Consumer side: broadcast_ring::consumer.
+ * All consumers must be added before the producer starts.
+ */
+template<class T>
+class broadcast_ring
+{
+    static_assert(std::is_default_constructible<T>::value,
+        "broadcast_ring requires default constructible events");
+
+    static constexpr std::size_t CACHE_LINE_SIZE = detail::concurrency::CACHE_LINE_SIZE;
+
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+    using pointer       = T*;
+
+    /**
+     * @brief Reading side of one consumer, used by a single thread
+     */
+    class consumer
+    {
+        friend class broadcast_ring;
+
+        //? Count of processed events, read by producer and dependents
+        alignas(CACHE_LINE_SIZE) std::atomic<size_type> m_sequence;
+        //? Consumer
+        alignas(CACHE_LINE_SIZE) broadcast_ring* m_ring;
+        std::vector<const consumer*> m_dependencies;
+        size_type m_available_cached;
+
+        consumer(broadcast_ring* ring, std::vector<const consumer*> dependencies, size_type sequence) :
+            m_sequence{sequence}, m_ring{ring},
+            m_dependencies{std::move(dependencies)}, m_available_cached{sequence}
+        {}
+
+        /**
+         * Events ready for the consumer, the barrier (cursor or sequences of
+         * dependencies) is read only if cached value gives less than count
+         */
+        size_type available_(size_type sequence, size_type count) noexcept
+        {
+            auto ready_count_ = m_available_cached - sequence;
+            if (ready_count_ < count)
+            {
+                if (m_dependencies.empty())
+                {
+                    m_available_cached = m_ring->m_cursor.load(std::memory_order_acquire);
+                }
+                else
+                {
+                    auto min_ = m_dependencies.front()->m_sequence.load(std::memory_order_acquire);
+                    for (auto* dependency_ : m_dependencies)
+                    {
+                        const auto sequence_ = dependency_->m_sequence.load(std::memory_order_acquire);
+                        min_ = sequence_ < min_ ? sequence_ : min_;
+                    }
+                    m_available_cached = min_;
+                }
+                ready_count_ = m_available_cached - sequence;
+            }
+            return ready_count_;
+        }
+
+      public:
+        consumer(const consumer&) = delete;
+        consumer& operator=(const consumer&) = delete;
+
+        /**
+         * @brief Count of events processed by the consumer
+         */
+        inline size_type sequence() const noexcept
+        {
+            return m_sequence.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Count of events ready for the consumer
+         */
+        inline size_type available() noexcept
+        {
+            return available_(m_sequence.load(std::memory_order_relaxed), ~size_type{0});
+        }
+
+        /**
+         * @brief Contiguous range of at most count oldest unprocessed events
+         * The range may be shorter than count when the events wrap around.
+         * Events may be modified for the dependent consumers.
+         */
+        ring_span<T> peek(size_type count) noexcept
+        {
+            const auto sequence_ = m_sequence.load(std::memory_order_relaxed);
+            const auto ready_count_ = available_(sequence_, count);
+            const auto contiguous_ = m_ring->capacity() - (sequence_ & m_ring->m_mask);
+            auto size_ = count < ready_count_ ? count : ready_count_;
+            size_ = size_ < contiguous_ ? size_ : contiguous_;
+            return {m_ring->slot_(sequence_), size_};
+        }
+
+        /**
+         * @brief Marks count oldest (peeked) events processed
+         */
+        inline void consume(size_type count) noexcept
+        {
+            m_sequence.store(m_sequence.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        /**
+         * @brief Calls f(T&) for up to count ready events, then marks them
+         * processed with one store
+         * @return Count of processed events
+         */
+        template<class F>
+        size_type poll(F&& f, size_type count = ~size_type{0})
+        {
+            const auto sequence_ = m_sequence.load(std::memory_order_relaxed);
+            const auto ready_count_ = available_(sequence_, count);
+            const auto polled_ = count < ready_count_ ? count : ready_count_;
+            for (size_type i{0}; i < polled_; ++i)
+            {
+                f(*m_ring->slot_(sequence_ + i));
+            }
+            m_sequence.store(sequence_ + polled_, std::memory_order_release);
+            return polled_;
+        }
+    };
+
+  private:
+    //? Read only after the consumers are added
+    alignas(CACHE_LINE_SIZE) std::unique_ptr<T[]> m_slots;
+    size_type m_mask;
+    std::vector<std::unique_ptr<consumer>> m_consumers;
+    std::vector<const consumer*> m_gating;
+    //? Producer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_type> m_cursor;
+    size_type m_gating_cached;
+
+    static size_type capacity_for_(size_type capacity)
+    {
+        if (capacity == 0 || capacity > (~size_type{0} >> 1) / sizeof(T))
+        {
+            throw std::length_error{"broadcast_ring length error"};
+        }
+        size_type r_{1};
+        while (r_ < capacity)
+        {
+            r_ <<= 1;
+        }
+        return r_;
+    }
+
+    inline pointer slot_(size_type index) const noexcept
+    {
+        return m_slots.get() + (index & m_mask);
+    }
+
+    /**
+     * Free slots for the producer, the sequences of the last consumers are
+     * read only if cached minimum gives less than count
+     */
+    size_type free_(size_type cursor, size_type count) noexcept
+    {
+        if (m_gating.empty())
+        {   //? Nobody reads the events
+            return capacity();
+        }
+        auto free_count_ = capacity() - (cursor - m_gating_cached);
+        if (free_count_ < count)
+        {
+            auto min_ = cursor;
+            for (auto* consumer_ : m_gating)
+            {
+                const auto sequence_ = consumer_->m_sequence.load(std::memory_order_acquire);
+                min_ = sequence_ < min_ ? sequence_ : min_;
+            }
+            m_gating_cached = min_;
+            free_count_ = capacity() - (cursor - m_gating_cached);
+        }
+        return free_count_;
+    }
+
+  public:
+    /**
+     * @brief Ring of at least capacity slots (rounded up to a power of two)
+     */
+    explicit broadcast_ring(size_type capacity) :
+        m_slots{nullptr}, m_mask{capacity_for_(capacity) - 1},
+        m_consumers{}, m_gating{}, m_cursor{0}, m_gating_cached{0}
+    {
+        m_slots.reset(new T[m_mask + 1]);
+    }
+
+    broadcast_ring(const broadcast_ring&) = delete;
+    broadcast_ring& operator=(const broadcast_ring&) = delete;
+
+    /**
+     * @brief Adds consumer that reads events after all dependencies
+     * processed them (or right after publish if there are none)
+     * The producer does not wait for the dependencies any more, only for
+     * the consumers that depend on them.
+     */
+    consumer& add_consumer(std::initializer_list<const consumer*> dependencies = {})
+    {
+        for (auto* dependency_ : dependencies)
+        {
+            if (!dependency_ || dependency_->m_ring != this)
+            {
+                throw std::invalid_argument{"broadcast_ring consumer error"};
+            }
+        }
+        //? Start after the last published event or the slowest dependency
+        auto start_ = m_cursor.load(std::memory_order_acquire);
+        for (auto* dependency_ : dependencies)
+        {
+            const auto sequence_ = dependency_->m_sequence.load(std::memory_order_acquire);
+            start_ = sequence_ < start_ ? sequence_ : start_;
+        }
+        m_consumers.emplace_back(new consumer{this, dependencies, start_});
+        for (auto* dependency_ : dependencies)
+        {
+            for (auto it_ = m_gating.begin(); it_ != m_gating.end(); ++it_)
+            {
+                if (*it_ == dependency_)
+                {
+                    m_gating.erase(it_);
+                    break;
+                }
+            }
+        }
+        m_gating.push_back(m_consumers.back().get());
+        m_gating_cached = m_gating.size() == 1 || start_ < m_gating_cached ? start_ : m_gating_cached;
+        return *m_consumers.back();
+    }
+
+    inline size_type capacity() const noexcept { return m_mask + 1; }
+
+    /**
+     * @brief Count of published events
+     */
+    inline size_type cursor() const noexcept
+    {
+        return m_cursor.load(std::memory_order_acquire);
+    }
+
+    /* Producer */
+
+    /**
+     * @brief Contiguous slots for at most count events
+     * The range may be shorter than count when the slowest consumers are
+     * behind or the free space wraps around. The slots hold old events
+     * that must be overwritten before publish().
+     */
+    ring_span<T> claim(size_type count) noexcept
+    {
+        const auto cursor_ = m_cursor.load(std::memory_order_relaxed);
+        const auto free_count_ = free_(cursor_, count);
+        const auto contiguous_ = capacity() - (cursor_ & m_mask);
+        auto size_ = count < free_count_ ? count : free_count_;
+        size_ = size_ < contiguous_ ? size_ : contiguous_;
+        return {slot_(cursor_), size_};
+    }
+
+    /**
+     * @brief Publishes count events written to claimed slots
+     */
+    inline void publish(size_type count) noexcept
+    {
+        m_cursor.store(m_cursor.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    template<class U>
+    bool try_push(U&& value) noexcept(std::is_nothrow_assignable<T&, U&&>::value)
+    {
+        const auto cursor_ = m_cursor.load(std::memory_order_relaxed);
+        if (!free_(cursor_, 1))
+        {
+            return false;
+        }
+        *slot_(cursor_) = std::forward<U>(value);
+        m_cursor.store(cursor_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Copies up to count events of src into the ring
+     * @return Count of published events
+     */
+    size_type push_n(const T* src, size_type count)
+        noexcept(std::is_nothrow_copy_assignable<T>::value)
+    {
+        const auto cursor_ = m_cursor.load(std::memory_order_relaxed);
+        const auto free_count_ = free_(cursor_, count);
+        const auto pushed_ = count < free_count_ ? count : free_count_;
+        for (size_type i{0}; i < pushed_; ++i)
+        {
+            *slot_(cursor_ + i) = src[i];
+        }
+        m_cursor.store(cursor_ + pushed_, std::memory_order_release);
+        return pushed_;
+    }
+};
+
+} // namespace containers
+
+template<class T>
+using broadcast_ring_t = containers::broadcast_ring<T>;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_BROADCAST_RING_HPP_ */
@@ -0,0 +1,447 @@
+#ifndef ECSL_CONTAINERS_CUCKOO_FILTER_HPP_
+#define ECSL_CONTAINERS_CUCKOO_FILTER_HPP_
+
+/**
+ * @file CuckooFilter.hpp
+ * Declares cuckoo filter: approximate set membership with deletion
+ *
+ * A key is a 16-bit fingerprint stored in one of two buckets of 4 slots
+ * (a bucket is one 64-bit word), the second bucket is the first one xor
+ * the hash of the fingerprint, so a fingerprint can be moved without its
+ * key. Both buckets of a query are compared with one SSE2/NEON compare
+ * of 8 16-bit lanes (SWAR on other targets).
+ *
+ * False positive rate is about 8 / 2^16 = 0.012% at full load, the table
+ * is filled up to about 95% (16.8 bits per key). Erasing a key that was
+ * not inserted may erase another key with the same fingerprint.
+ *
+ * Fingerprints can not be rehashed into a larger table, so growth appends
+ * a table of twice the size when the newest one overflows: queries check
+ * every table (log2 of the growth count), the false positive rate adds up.
+ * Construct with the expected count of keys to keep a single table.
+ * A key is stored at most SLOTS times per table (further insertions of it
+ * are ignored) and the filter grows at most 16 times.
+ *
+ * Sources:
+ *  B. Fan, D. G. Andersen, M. Kaminsky, M. D. Mitzenmacher "Cuckoo Filter:
+ *  Practically Better Than Bloom" CoNEXT 2014
+ *  H. Chen et al. "The Dynamic Cuckoo Filter" ICNP 2017 (growth)
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+/// ECSL
+#include <ecsl/platform/Simd.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace cuckoo_filter {
+
+using bucket_t      = std::uint64_t;
+using fingerprint_t = std::uint16_t;
+
+constexpr std::size_t SLOTS = sizeof(bucket_t) / sizeof(fingerprint_t);
+constexpr std::size_t FINGERPRINT_BITS = sizeof(fingerprint_t) * CHAR_BIT;
+constexpr bucket_t LANES_LOW = 0x0001000100010001ull;
+constexpr bucket_t LANES_HIGH = 0x8000800080008000ull;
+constexpr std::size_t MAX_KICKS = 500;
+//? Copies of a fingerprint in its two buckets, more would fill both and
+//? make every further insertion of the key fail and grow the filter
+constexpr std::size_t MAX_COPIES = SLOTS;
+//? Tables appended by growth, a filter of 2^MAX_GROWTH times the initial size
+constexpr std::size_t MAX_GROWTH = 16;
+
+/**
+ * Murmur3 finalizer: hashes of std::hash may be the identity
+ */
+constexpr std::uint64_t mix(std::uint64_t h) noexcept
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+//? Zero is the empty slot
+constexpr fingerprint_t fingerprint(std::uint64_t h) noexcept
+{
+    return static_cast<fingerprint_t>((h >> (64 - FINGERPRINT_BITS)) |
+        ((h >> (64 - FINGERPRINT_BITS)) == 0));
+}
+
+/**
+ * High bit of every 16-bit lane equal to fp (exact, no borrow between lanes)
+ */
+constexpr bucket_t match(bucket_t bucket, fingerprint_t fp) noexcept
+{
+    const bucket_t x_ = bucket ^ (fp * LANES_LOW);
+    return ~(((x_ & ~LANES_HIGH) + ~LANES_HIGH) | x_ | ~LANES_HIGH);
+}
+
+inline bool match_any(bucket_t a, bucket_t b, fingerprint_t fp) noexcept
+{
+#if defined(ECSL_SIMD_SSE2)
+    const __m128i buckets_ = _mm_set_epi64x(static_cast<long long>(b), static_cast<long long>(a));
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(buckets_, _mm_set1_epi16(static_cast<short>(fp)))) != 0;
+#elif defined(ECSL_SIMD_NEON)
+    const uint16x8_t buckets_ = vreinterpretq_u16_u64(vcombine_u64(vcreate_u64(a), vcreate_u64(b)));
+    const uint64x2_t eq_ = vreinterpretq_u64_u16(vceqq_u16(buckets_, vdupq_n_u16(fp)));
+    return (vgetq_lane_u64(eq_, 0) | vgetq_lane_u64(eq_, 1)) != 0;
+#else
+    return (match(a, fp) | match(b, fp)) != 0;
+#endif
+}
+
+constexpr std::size_t lane_count(bucket_t matches) noexcept
+{
+    std::size_t r_{0};
+    for (; matches; matches &= matches - 1)
+    {
+        ++r_;
+    }
+    return r_;
+}
+
+constexpr std::size_t lane(bucket_t matches) noexcept
+{
+    std::size_t r_{0};
+    for (; !(matches & (LANES_HIGH & (bucket_t{0xFFFF} << (r_ * FINGERPRINT_BITS)))); ++r_)
+    {}
+    return r_;
+}
+
+constexpr bucket_t set_lane(bucket_t bucket, std::size_t slot, fingerprint_t fp) noexcept
+{
+    return (bucket & ~(bucket_t{0xFFFF} << (slot * FINGERPRINT_BITS))) |
+        (static_cast<bucket_t>(fp) << (slot * FINGERPRINT_BITS));
+}
+
+constexpr fingerprint_t get_lane(bucket_t bucket, std::size_t slot) noexcept
+{
+    return static_cast<fingerprint_t>(bucket >> (slot * FINGERPRINT_BITS));
+}
+
+/**
+ * Power of two count of buckets with a one fingerprint stash for overflow
+ */
+struct table
+{
+    std::vector<bucket_t> m_buckets;
+    std::size_t m_mask;
+    std::size_t m_count;
+    std::uint64_t m_seed;
+    //? Fingerprint evicted by the last failed insertion (0 if none)
+    fingerprint_t m_victim;
+    std::size_t m_victim_bucket;
+
+    explicit table(std::size_t buckets) :
+        m_buckets(buckets, 0), m_mask{buckets - 1}, m_count{0},
+        m_seed{0x9E3779B97F4A7C15ull}, m_victim{0}, m_victim_bucket{0}
+    {}
+
+    inline std::size_t alternate(std::size_t bucket, fingerprint_t fp) const noexcept
+    {
+        return (bucket ^ (fp * std::size_t{0x5bd1e995})) & m_mask;
+    }
+
+    inline bool full() const noexcept { return m_victim != 0; }
+
+    inline std::size_t slots() const noexcept { return m_buckets.size() * SLOTS; }
+
+    bool contains(std::size_t bucket, fingerprint_t fp) const noexcept
+    {
+        const auto alternate_ = alternate(bucket, fp);
+        return match_any(m_buckets[bucket], m_buckets[alternate_], fp) ||
+            (m_victim == fp && (m_victim_bucket == bucket || m_victim_bucket == alternate_));
+    }
+
+    bool try_place(std::size_t bucket, fingerprint_t fp) noexcept
+    {
+        const auto empty_ = match(m_buckets[bucket], 0);
+        if (!empty_)
+        {
+            return false;
+        }
+        m_buckets[bucket] = set_lane(m_buckets[bucket], lane(empty_), fp);
+        return true;
+    }
+
+    std::size_t copies(std::size_t bucket, fingerprint_t fp) const noexcept
+    {
+        const auto alternate_ = alternate(bucket, fp);
+        auto r_ = lane_count(match(m_buckets[bucket], fp));
+        if (alternate_ != bucket)
+        {
+            r_ += lane_count(match(m_buckets[alternate_], fp));
+        }
+        return r_;
+    }
+
+    /**
+     * Inserts fp, the table must not be full()
+     * @return false if fp already has MAX_COPIES copies (nothing inserted)
+     */
+    bool insert(std::size_t bucket, fingerprint_t fp) noexcept
+    {
+        if (copies(bucket, fp) >= MAX_COPIES)
+        {
+            return false;
+        }
+        place_(bucket, fp);
+        return true;
+    }
+
+    /**
+     * Places fp into one of its buckets or kicks fingerprints out until
+     * one finds a free slot, the last evicted one goes to the victim stash
+     */
+    void place_(std::size_t bucket, fingerprint_t fp) noexcept
+    {
+        ++m_count;
+        if (try_place(bucket, fp) || try_place(alternate(bucket, fp), fp))
+        {
+            return;
+        }
+        for (std::size_t kick_{0}; kick_ < MAX_KICKS; ++kick_)
+        {
+            //? xorshift: slot and bucket choices need not be strong
+            m_seed ^= m_seed << 13;
+            m_seed ^= m_seed >> 7;
+            m_seed ^= m_seed << 17;
+            if (m_seed & SLOTS)
+            {
+                bucket = alternate(bucket, fp);
+            }
+            const auto slot_ = static_cast<std::size_t>(m_seed % SLOTS);
+            const auto evicted_ = get_lane(m_buckets[bucket], slot_);
+            m_buckets[bucket] = set_lane(m_buckets[bucket], slot_, fp);
+            fp = evicted_;
+            bucket = alternate(bucket, fp);
+            if (try_place(bucket, fp))
+            {
+                return;
+            }
+        }
+        m_victim = fp;
+        m_victim_bucket = bucket;
+    }
+
+    bool erase(std::size_t bucket, fingerprint_t fp) noexcept
+    {
+        const auto alternate_ = alternate(bucket, fp);
+        for (const auto b_ : {bucket, alternate_})
+        {
+            const auto matches_ = match(m_buckets[b_], fp);
+            if (matches_)
+            {
+                m_buckets[b_] = set_lane(m_buckets[b_], lane(matches_), 0);
+                --m_count;
+                //? The freed slot may take the stashed fingerprint back
+                if (m_victim)
+                {
+                    const auto victim_ = m_victim;
+                    m_victim = 0;
+                    --m_count;
+                    place_(m_victim_bucket, victim_);
+                }
+                return true;
+            }
+        }
+        if (m_victim == fp && (m_victim_bucket == bucket || m_victim_bucket == alternate_))
+        {
+            m_victim = 0;
+            --m_count;
+            return true;
+        }
+        return false;
+    }
+};
+
+} // namespace cuckoo_filter
+} // namespace detail
+
+/**
+ * @brief Approximate set of hashes with insertion and deletion
+ */
+class cuckoo_filter
+{
+    using table_t = detail::cuckoo_filter::table;
+
+  public:
+    using size_type     = std::size_t;
+
+    static constexpr size_type SLOTS = detail::cuckoo_filter::SLOTS;
+    //? Expected load factor of a table before its first insertion failure
+    static constexpr double MAX_LOAD = 0.95;
+
+  private:
+    std::vector<table_t> m_tables;
+
+    static size_type buckets_for_(size_type capacity) noexcept
+    {
+        const auto needed_ = static_cast<size_type>(
+            static_cast<double>(capacity) / (SLOTS * MAX_LOAD)) + 1;
+        size_type r_{1};
+        while (r_ < needed_)
+        {
+            r_ <<= 1;
+        }
+        return r_;
+    }
+
+  public:
+    /**
+     * @brief Filter for capacity keys in a single table
+     */
+    explicit cuckoo_filter(size_type capacity = 0)
+    {
+        m_tables.emplace_back(buckets_for_(capacity));
+    }
+
+    /**
+     * @brief Count of stored fingerprints
+     */
+    size_type size() const noexcept
+    {
+        size_type r_{0};
+        for (const auto& t_ : m_tables)
+        {
+            r_ += t_.m_count;
+        }
+        return r_;
+    }
+
+    inline bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Count of fingerprint slots in all tables
+     */
+    size_type capacity() const noexcept
+    {
+        size_type r_{0};
+        for (const auto& t_ : m_tables)
+        {
+            r_ += t_.slots();
+        }
+        return r_;
+    }
+
+    inline double load_factor() const noexcept
+    {
+        return static_cast<double>(size()) / static_cast<double>(capacity());
+    }
+
+    /**
+     * @brief Count of tables (1 until the first growth)
+     */
+    inline size_type table_count() const noexcept { return m_tables.size(); }
+
+    /**
+     * @brief Memory of the tables in bytes
+     */
+    inline size_type bytes() const noexcept
+    {
+        return capacity() * sizeof(detail::cuckoo_filter::fingerprint_t);
+    }
+
+    /**
+     * @brief Removes all keys and drops the tables added by growth
+     */
+    void clear()
+    {
+        m_tables.erase(m_tables.begin() + 1, m_tables.end());
+        m_tables.front() = table_t{m_tables.front().m_buckets.size()};
+    }
+
+    /* Hash interface: hashes are mixed, so weak hashes are acceptable */
+
+    /**
+     * @brief Inserts the hash (duplicates are stored again up to SLOTS
+     * copies), throws std::length_error if the filter can not grow anymore
+     * @return false if the copy was not stored (the hash is contained)
+     */
+    bool insert_hash(std::uint64_t hash)
+    {
+        using namespace detail::cuckoo_filter;
+        if (m_tables.back().full())
+        {
+            if (m_tables.size() > MAX_GROWTH)
+            {
+                throw std::length_error{"cuckoo_filter length error"};
+            }
+            m_tables.emplace_back(m_tables.back().m_buckets.size() * 2);
+        }
+        const auto h_ = mix(hash);
+        auto& table_ = m_tables.back();
+        return table_.insert(static_cast<size_type>(h_) & table_.m_mask, fingerprint(h_));
+    }
+
+    bool contains_hash(std::uint64_t hash) const noexcept
+    {
+        using namespace detail::cuckoo_filter;
+        const auto h_ = mix(hash);
+        const auto fp_ = fingerprint(h_);
+        for (const auto& t_ : m_tables)
+        {
+            if (t_.contains(static_cast<size_type>(h_) & t_.m_mask, fp_))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Erases one copy of the hash
+     * @return true if a matching fingerprint was found
+     */
+    bool erase_hash(std::uint64_t hash) noexcept
+    {
+        using namespace detail::cuckoo_filter;
+        const auto h_ = mix(hash);
+        const auto fp_ = fingerprint(h_);
+        for (size_type i{m_tables.size()}; i-- > 0;)
+        {
+            if (m_tables[i].erase(static_cast<size_type>(h_) & m_tables[i].m_mask, fp_))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* Key interface */
+
+    template<class Key, class Hash = std::hash<Key>>
+    inline bool insert(const Key& key, const Hash& hash = Hash{})
+    {
+        return insert_hash(static_cast<std::uint64_t>(hash(key)));
+    }
+
+    template<class Key, class Hash = std::hash<Key>>
+    inline bool contains(const Key& key, const Hash& hash = Hash{}) const
+    {
+        return contains_hash(static_cast<std::uint64_t>(hash(key)));
+    }
+
+    template<class Key, class Hash = std::hash<Key>>
+    inline bool erase(const Key& key, const Hash& hash = Hash{})
+    {
+        return erase_hash(static_cast<std::uint64_t>(hash(key)));
+    }
+};
+
+} // namespace containers
+
+using cuckoo_filter_t = containers::cuckoo_filter;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_CUCKOO_FILTER_HPP_ */
@@ -0,0 +1,812 @@
+#ifndef ECSL_CONTAINERS_DYNAMIC_BITSET_HPP_
+#define ECSL_CONTAINERS_DYNAMIC_BITSET_HPP_
+
+/**
+ * @file DynamicBitset.hpp
+ * Declares run time sized bit vector with bulk operations vectorized
+ * with run time dispatch (AVX-512/AVX2/popcnt/portable)
+ *
+ * Storage is a heap array of 64-bit words aligned and padded to 64 bytes
+ * (one cache line, one AVX-512 register), so the kernels have no tails.
+ * Bits past size() are always zero.
+ * Fused operations (count_and, count_or, count_xor, count_and_not,
+ * intersects) combine the words in registers and never materialize a & b.
+ * Sources:
+ *  W. Mula, N. Kurz, D. Lemire "Faster Population Counts Using AVX2
+ *  Instructions" https://arxiv.org/abs/1611.07612
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+/// ECSL
+#include <ecsl/containers/MinimalBitset.hpp>
+#include <ecsl/platform/CpuFeatures.hpp>
+#include <ecsl/platform/Simd.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace dynamic_bitset {
+
+using word_t = std::uint64_t;
+
+enum class bit_op
+{
+    FIRST,
+    AND,
+    OR,
+    XOR,
+    AND_NOT,
+};
+
+template<bit_op OP>
+constexpr word_t combine_(word_t a, word_t b) noexcept
+{
+    return OP == bit_op::AND ? a & b :
+        OP == bit_op::OR ? a | b :
+        OP == bit_op::XOR ? a ^ b :
+        OP == bit_op::AND_NOT ? a & ~b :
+        a;
+}
+
+template<bit_op OP>
+inline void apply_scalar_(word_t* dst, const word_t* src, std::size_t count) noexcept
+{
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        dst[i] = combine_<OP>(dst[i], src[i]);
+    }
+}
+
+template<bit_op OP>
+inline std::size_t count_scalar_(const word_t* a, const word_t* b, std::size_t count) noexcept
+{
+    std::size_t r_{0};
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        r_ += minimal_bitset::popcount_(combine_<OP>(a[i], b[i]));
+    }
+    return r_;
+}
+
+template<bit_op OP>
+inline bool any_scalar_(const word_t* a, const word_t* b, std::size_t count) noexcept
+{
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        if (combine_<OP>(a[i], b[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(ECSL_SIMD_DISPATCH)
+
+/**
+ * Same as count_scalar_ but with popcnt instruction
+ */
+template<bit_op OP>
+ECSL_SIMD_TARGET("popcnt")
+inline std::size_t count_popcnt_(const word_t* a, const word_t* b, std::size_t count) noexcept
+{
+    std::size_t r_{0};
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        r_ += static_cast<std::size_t>(_mm_popcnt_u64(combine_<OP>(a[i], b[i])));
+    }
+    return r_;
+}
+
+template<bit_op OP>
+ECSL_SIMD_TARGET("avx2")
+inline __m256i combine_avx2_(__m256i a, __m256i b) noexcept
+{
+    switch (OP)
+    {
+        case bit_op::AND: return _mm256_and_si256(a, b);
+        case bit_op::OR: return _mm256_or_si256(a, b);
+        case bit_op::XOR: return _mm256_xor_si256(a, b);
+        case bit_op::AND_NOT: return _mm256_andnot_si256(b, a);
+        default: return a;
+    }
+}
+
+template<bit_op OP>
+ECSL_SIMD_TARGET("avx2")
+inline void apply_avx2_(word_t* dst, const word_t* src, std::size_t count) noexcept
+{
+    std::size_t i{0};
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i a_ = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i b_ = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), combine_avx2_<OP>(a_, b_));
+    }
+    apply_scalar_<OP>(dst + i, src + i, count - i);
+}
+
+ECSL_SIMD_TARGET("avx2")
+inline __m256i popcount_bytes_avx2_(__m256i v, __m256i lookup, __m256i low) noexcept
+{
+    const __m256i lo_ = _mm256_and_si256(v, low);
+    const __m256i hi_ = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo_), _mm256_shuffle_epi8(lookup, hi_));
+}
+
+/**
+ * Population count with pshufb nibble lookup and psadbw accumulation
+ */
+template<bit_op OP>
+ECSL_SIMD_TARGET("avx2")
+inline std::size_t count_avx2_(const word_t* a, const word_t* b, std::size_t count) noexcept
+{
+    const __m256i lookup_ = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_ = _mm256_set1_epi8(0x0F);
+    __m256i acc_ = _mm256_setzero_si256();
+    std::size_t i{0};
+    for (; i + 8 <= count; i += 8)
+    {
+        //? Two vectors give at most 16 per byte: no byte overflow
+        const __m256i x_ = combine_avx2_<OP>(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        const __m256i y_ = combine_avx2_<OP>(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 4)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 4)));
+        acc_ = _mm256_add_epi64(acc_, _mm256_sad_epu8(
+            _mm256_add_epi8(popcount_bytes_avx2_(x_, lookup_, low_),
+                popcount_bytes_avx2_(y_, lookup_, low_)), _mm256_setzero_si256()));
+    }
+    const __m128i sum_ = _mm_add_epi64(
+        _mm256_castsi256_si128(acc_), _mm256_extracti128_si256(acc_, 1));
+    return static_cast<std::size_t>(_mm_cvtsi128_si64(sum_) + _mm_extract_epi64(sum_, 1)) +
+        count_popcnt_<OP>(a + i, b + i, count - i);
+}
+
+template<bit_op OP>
+ECSL_SIMD_TARGET("avx2")
+inline bool any_avx2_(const word_t* a, const word_t* b, std::size_t count) noexcept
+{
+    std::size_t i{0};
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i v_ = combine_avx2_<OP>(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        if (!_mm256_testz_si256(v_, v_))
+        {
+            return true;
+        }
+    }
+    return any_scalar_<OP>(a + i, b + i, count - i);
+}
+
+template<bit_op OP>
+ECSL_SIMD_TARGET("avx512f")
+inline __m512i combine_avx512_(__m512i a, __m512i b) noexcept
+{
+    switch (OP)
+    {
+        case bit_op::AND: return _mm512_and_si512(a, b);
+        case bit_op::OR: return _mm512_or_si512(a, b);
+        case bit_op::XOR: return _mm512_xor_si512(a, b);
+        //? maskz form: the plain one trips -Wmaybe-uninitialized in GCC 12 headers
+        case bit_op::AND_NOT: return _mm512_maskz_andnot_epi64(0xFF, b, a);
+        default: return a;
+    }
+}
+
+template<bit_op OP>
+ECSL_SIMD_TARGET("avx512f")
+inline void apply_avx512_(word_t* dst, const word_t* src, std::size_t count) noexcept
+{
+    std::size_t i{0};
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm512_storeu_si512(dst + i, combine_avx512_<OP>(
+            _mm512_loadu_si512(dst + i), _mm512_loadu_si512(src + i)));
+    }
+    apply_scalar_<OP>(dst + i, src + i, count - i);
+}
+
+template<bit_op OP>
+ECSL_SIMD_TARGET("avx512f,avx512vpopcntdq")
+inline std::size_t count_avx512_(const word_t* a, const word_t* b, std::size_t count) noexcept
+{
+    __m512i acc_ = _mm512_setzero_si512();
+    std::size_t i{0};
+    for (; i + 8 <= count; i += 8)
+    {
+        acc_ = _mm512_add_epi64(acc_, _mm512_popcnt_epi64(combine_avx512_<OP>(
+            _mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i))));
+    }
+    //? _mm512_reduce_add_epi64 trips -Wuninitialized in GCC 12 headers
+    alignas(64) std::uint64_t lanes_[8];
+    _mm512_store_si512(lanes_, acc_);
+    std::size_t r_{0};
+    for (const auto lane_ : lanes_)
+    {
+        r_ += static_cast<std::size_t>(lane_);
+    }
+    return r_ + count_popcnt_<OP>(a + i, b + i, count - i);
+}
+
+template<bit_op OP>
+ECSL_SIMD_TARGET("avx512f")
+inline bool any_avx512_(const word_t* a, const word_t* b, std::size_t count) noexcept
+{
+    std::size_t i{0};
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m512i v_ = combine_avx512_<OP>(
+            _mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        if (_mm512_test_epi64_mask(v_, v_))
+        {
+            return true;
+        }
+    }
+    return any_scalar_<OP>(a + i, b + i, count - i);
+}
+
+#endif /* ECSL_SIMD_DISPATCH */
+
+/**
+ * dst[i] = dst[i] OP src[i]
+ */
+template<bit_op OP>
+inline void apply(word_t* dst, const word_t* src, std::size_t words) noexcept
+{
+#if defined(ECSL_SIMD_DISPATCH)
+    const auto& cpu_ = runtime_cpu_features();
+    if (cpu_.avx512f)
+    {
+        return apply_avx512_<OP>(dst, src, words);
+    }
+    if (cpu_.avx2)
+    {
+        return apply_avx2_<OP>(dst, src, words);
+    }
+#endif
+    apply_scalar_<OP>(dst, src, words);
+}
+
+/**
+ * Population count of a[i] OP b[i]
+ */
+template<bit_op OP>
+inline std::size_t count(const word_t* a, const word_t* b, std::size_t words) noexcept
+{
+#if defined(ECSL_SIMD_DISPATCH)
+    const auto& cpu_ = runtime_cpu_features();
+    if (cpu_.avx512vpopcntdq)
+    {
+        return count_avx512_<OP>(a, b, words);
+    }
+    if (cpu_.avx2 && cpu_.popcnt)
+    {
+        return count_avx2_<OP>(a, b, words);
+    }
+    if (cpu_.popcnt)
+    {
+        return count_popcnt_<OP>(a, b, words);
+    }
+#endif
+    return count_scalar_<OP>(a, b, words);
+}
+
+/**
+ * Checks if any of a[i] OP b[i] is non zero
+ */
+template<bit_op OP>
+inline bool any(const word_t* a, const word_t* b, std::size_t words) noexcept
+{
+#if defined(ECSL_SIMD_DISPATCH)
+    const auto& cpu_ = runtime_cpu_features();
+    if (cpu_.avx512f)
+    {
+        return any_avx512_<OP>(a, b, words);
+    }
+    if (cpu_.avx2)
+    {
+        return any_avx2_<OP>(a, b, words);
+    }
+#endif
+    return any_scalar_<OP>(a, b, words);
+}
+
+} // namespace dynamic_bitset
+} // namespace detail
+
+/**
+ * @brief Run time sized bit vector
+ * Operations on bitsets of different sizes treat missing bits as zeros
+ * and keep the size of the left operand (like minimal_bitset).
+ */
+class dynamic_bitset
+{
+    using bit_op = detail::dynamic_bitset::bit_op;
+
+  public:
+    using word_type     = detail::dynamic_bitset::word_t;
+    using size_type     = std::size_t;
+
+    static constexpr size_type BITS_IN_WORD = sizeof(word_type) * CHAR_BIT;
+    static constexpr size_type ALIGNMENT = 64;
+    static constexpr size_type BLOCK_WORDS = ALIGNMENT / sizeof(word_type);
+
+  private:
+    word_type* m_words;
+    size_type m_bits;
+    //? Allocated words, multiple of BLOCK_WORDS
+    size_type m_capacity;
+
+    static constexpr size_type words_for_(size_type bits) noexcept
+    {
+        return (bits + BITS_IN_WORD * BLOCK_WORDS - 1) /
+            (BITS_IN_WORD * BLOCK_WORDS) * BLOCK_WORDS;
+    }
+
+    static word_type* allocate_(size_type words)
+    {
+        return words ? static_cast<word_type*>(::operator new(
+            words * sizeof(word_type), std::align_val_t{ALIGNMENT})) : nullptr;
+    }
+
+    static void deallocate_(word_type* words) noexcept
+    {
+        if (words)
+        {
+            ::operator delete(words, std::align_val_t{ALIGNMENT});
+        }
+    }
+
+    /**
+     * Words covering size() bits padded to the block
+     */
+    inline size_type blocks_words_() const noexcept
+    {
+        return words_for_(m_bits);
+    }
+
+    /**
+     * Zeroes bits past size() up to the end word
+     */
+    void clear_padding_(size_type end) noexcept
+    {
+        const auto used_ = word_count();
+        if (m_bits % BITS_IN_WORD)
+        {
+            m_words[used_ - 1] &= ~word_type{0} >> (BITS_IN_WORD - m_bits % BITS_IN_WORD);
+        }
+        for (size_type i{used_}; i < end; ++i)
+        {
+            m_words[i] = 0;
+        }
+    }
+
+    inline void clear_padding_() noexcept
+    {
+        clear_padding_(blocks_words_());
+    }
+
+    template<bit_op OP>
+    dynamic_bitset& apply_(const dynamic_bitset& other) noexcept
+    {
+        const auto words_ = blocks_words_();
+        const auto common_ = words_ < other.blocks_words_() ? words_ : other.blocks_words_();
+        detail::dynamic_bitset::apply<OP>(m_words, other.m_words, common_);
+        if (OP == bit_op::AND)
+        {
+            for (size_type i{common_}; i < words_; ++i)
+            {
+                m_words[i] = 0;
+            }
+        }
+        if (words_)
+        {
+            clear_padding_();
+        }
+        return *this;
+    }
+
+    /**
+     * Count of bits of (a OP b) within a.size(), as the binary operators
+     * keep the size of the left operand
+     */
+    template<bit_op OP>
+    static size_type count_(const dynamic_bitset& a, const dynamic_bitset& b) noexcept
+    {
+        const auto full_ = a.m_bits / BITS_IN_WORD;
+        const auto b_words_ = b.blocks_words_();
+        const auto common_ = full_ < b_words_ ? full_ : b_words_;
+        auto r_ = detail::dynamic_bitset::count<OP>(a.m_words, b.m_words, common_);
+        //? Full words of a past the end of b combined with zeros
+        if (OP != bit_op::AND && full_ > common_)
+        {
+            r_ += detail::dynamic_bitset::count<bit_op::FIRST>(
+                a.m_words + common_, a.m_words + common_, full_ - common_);
+        }
+        //? Last partial word of a, bits of b past a.size() do not count
+        if (a.m_bits % BITS_IN_WORD)
+        {
+            const auto b_word_ = full_ < b_words_ ? b.m_words[full_] : word_type{0};
+            r_ += detail::minimal_bitset::popcount_(
+                detail::dynamic_bitset::combine_<OP>(a.m_words[full_], b_word_) &
+                (~word_type{0} >> (BITS_IN_WORD - a.m_bits % BITS_IN_WORD)));
+        }
+        return r_;
+    }
+
+  public:
+    dynamic_bitset() noexcept : m_words{nullptr}, m_bits{0}, m_capacity{0} {}
+
+    explicit dynamic_bitset(size_type bits, bool value = false) :
+        dynamic_bitset()
+    {
+        resize(bits, value);
+    }
+
+    dynamic_bitset(const dynamic_bitset& other) :
+        m_words{allocate_(other.blocks_words_())},
+        m_bits{other.m_bits},
+        m_capacity{other.blocks_words_()}
+    {
+        if (m_capacity)
+        {
+            std::memcpy(m_words, other.m_words, m_capacity * sizeof(word_type));
+        }
+    }
+
+    dynamic_bitset(dynamic_bitset&& other) noexcept :
+        m_words{other.m_words}, m_bits{other.m_bits}, m_capacity{other.m_capacity}
+    {
+        other.m_words = nullptr;
+        other.m_bits = 0;
+        other.m_capacity = 0;
+    }
+
+    dynamic_bitset& operator=(const dynamic_bitset& other)
+    {
+        if (this != &other)
+        {
+            dynamic_bitset tmp_{other};
+            swap(tmp_);
+        }
+        return *this;
+    }
+
+    dynamic_bitset& operator=(dynamic_bitset&& other) noexcept
+    {
+        dynamic_bitset tmp_{std::move(other)};
+        swap(tmp_);
+        return *this;
+    }
+
+    ~dynamic_bitset() noexcept
+    {
+        deallocate_(m_words);
+    }
+
+    void swap(dynamic_bitset& other) noexcept
+    {
+        std::swap(m_words, other.m_words);
+        std::swap(m_bits, other.m_bits);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+    /**
+     * @brief Changes size, new bits are set to value
+     */
+    void resize(size_type bits, bool value = false)
+    {
+        const auto words_ = words_for_(bits);
+        if (words_ > m_capacity)
+        {
+            auto* words_ptr_ = allocate_(words_);
+            if (m_capacity)
+            {
+                std::memcpy(words_ptr_, m_words, m_capacity * sizeof(word_type));
+            }
+            std::memset(words_ptr_ + m_capacity, 0,
+                (words_ - m_capacity) * sizeof(word_type));
+            deallocate_(m_words);
+            m_words = words_ptr_;
+            m_capacity = words_;
+        }
+        const auto old_ = m_bits;
+        m_bits = bits;
+        if (value && bits > old_)
+        {
+            size_type i{old_};
+            for (; i < bits && i % BITS_IN_WORD; ++i)
+            {
+                set(i);
+            }
+            for (; i < bits; i += BITS_IN_WORD)
+            {
+                m_words[i / BITS_IN_WORD] = ~word_type{0};
+            }
+        }
+        if (m_capacity)
+        {   //? Shrinked bits must not appear on growth
+            clear_padding_(old_ > bits ? words_for_(old_) : words_for_(bits));
+        }
+    }
+
+    inline void clear() noexcept
+    {
+        resize(0);
+    }
+
+    inline size_type size() const noexcept { return m_bits; }
+    inline bool empty() const noexcept { return m_bits == 0; }
+
+    /**
+     * @brief Count of words holding size() bits
+     */
+    inline size_type word_count() const noexcept
+    {
+        return (m_bits + BITS_IN_WORD - 1) / BITS_IN_WORD;
+    }
+
+    inline word_type* data() noexcept { return m_words; }
+    inline const word_type* data() const noexcept { return m_words; }
+
+    /* Single bit access: out of range positions are ignored */
+
+    inline void set(size_type position) noexcept
+    {
+        if (position < m_bits)
+        {
+            m_words[position / BITS_IN_WORD] |= word_type{1} << (position % BITS_IN_WORD);
+        }
+    }
+
+    inline void reset(size_type position) noexcept
+    {
+        if (position < m_bits)
+        {
+            m_words[position / BITS_IN_WORD] &= ~(word_type{1} << (position % BITS_IN_WORD));
+        }
+    }
+
+    inline void flip(size_type position) noexcept
+    {
+        if (position < m_bits)
+        {
+            m_words[position / BITS_IN_WORD] ^= word_type{1} << (position % BITS_IN_WORD);
+        }
+    }
+
+    inline bool test(size_type position) const noexcept
+    {
+        return position < m_bits &&
+            ((m_words[position / BITS_IN_WORD] >> (position % BITS_IN_WORD)) & 1);
+    }
+
+    inline bool operator[](size_type position) const noexcept
+    {
+        return (m_words[position / BITS_IN_WORD] >> (position % BITS_IN_WORD)) & 1;
+    }
+
+    bool at(size_type position) const
+    {
+        if (position < m_bits)
+        {
+            return operator[](position);
+        }
+        throw std::out_of_range{"dynamic_bitset range check failed"};
+    }
+
+    /* Whole set */
+
+    void set() noexcept
+    {
+        for (size_type i{0}; i < word_count(); ++i)
+        {
+            m_words[i] = ~word_type{0};
+        }
+        if (m_capacity)
+        {
+            clear_padding_();
+        }
+    }
+
+    void reset() noexcept
+    {
+        for (size_type i{0}; i < word_count(); ++i)
+        {
+            m_words[i] = 0;
+        }
+    }
+
+    void flip() noexcept
+    {
+        for (size_type i{0}; i < word_count(); ++i)
+        {
+            m_words[i] = ~m_words[i];
+        }
+        if (m_capacity)
+        {
+            clear_padding_();
+        }
+    }
+
+    inline size_type count() const noexcept
+    {
+        return detail::dynamic_bitset::count<bit_op::FIRST>(m_words, m_words, blocks_words_());
+    }
+
+    inline bool any() const noexcept
+    {
+        return detail::dynamic_bitset::any<bit_op::FIRST>(m_words, m_words, blocks_words_());
+    }
+
+    inline bool none() const noexcept
+    {
+        return !any();
+    }
+
+    inline bool all() const noexcept
+    {
+        return count() == m_bits;
+    }
+
+    /* Search: positions are returned as size_type, size() if not found */
+
+    size_type find_first() const noexcept
+    {
+        return find_from_(0);
+    }
+
+    size_type find_next(size_type position) const noexcept
+    {
+        return position < m_bits ? find_from_(position + 1) : m_bits;
+    }
+
+  private:
+    size_type find_from_(size_type pos) const noexcept
+    {
+        if (pos >= m_bits)
+        {
+            return m_bits;
+        }
+        size_type word_ = pos / BITS_IN_WORD;
+        auto bits_ = m_words[word_] & (~word_type{0} << (pos % BITS_IN_WORD));
+        while (!bits_)
+        {
+            if (++word_ == word_count())
+            {
+                return m_bits;
+            }
+            bits_ = m_words[word_];
+        }
+        return word_ * BITS_IN_WORD + detail::minimal_bitset::lowest_bit_(bits_);
+    }
+
+  public:
+    /* Bulk operations */
+
+    inline dynamic_bitset& operator&=(const dynamic_bitset& other) noexcept
+    {
+        return apply_<bit_op::AND>(other);
+    }
+
+    inline dynamic_bitset& operator|=(const dynamic_bitset& other) noexcept
+    {
+        return apply_<bit_op::OR>(other);
+    }
+
+    inline dynamic_bitset& operator^=(const dynamic_bitset& other) noexcept
+    {
+        return apply_<bit_op::XOR>(other);
+    }
+
+    /**
+     * @brief this &= ~other
+     */
+    inline dynamic_bitset& and_not(const dynamic_bitset& other) noexcept
+    {
+        return apply_<bit_op::AND_NOT>(other);
+    }
+
+    dynamic_bitset operator~() const
+    {
+        auto tmp_ = *this;
+        tmp_.flip();
+        return tmp_;
+    }
+
+    /* Fused operations: no temporary bitset is created */
+
+    /**
+     * @brief (a & b).count()
+     */
+    friend inline size_type count_and(const dynamic_bitset& a, const dynamic_bitset& b) noexcept
+    {
+        return count_<bit_op::AND>(a, b);
+    }
+
+    /**
+     * @brief (a | b).count()
+     */
+    friend inline size_type count_or(const dynamic_bitset& a, const dynamic_bitset& b) noexcept
+    {
+        return count_<bit_op::OR>(a, b);
+    }
+
+    /**
+     * @brief (a ^ b).count()
+     */
+    friend inline size_type count_xor(const dynamic_bitset& a, const dynamic_bitset& b) noexcept
+    {
+        return count_<bit_op::XOR>(a, b);
+    }
+
+    /**
+     * @brief (a & ~b).count()
+     */
+    friend inline size_type count_and_not(const dynamic_bitset& a, const dynamic_bitset& b) noexcept
+    {
+        return count_<bit_op::AND_NOT>(a, b);
+    }
+
+    /**
+     * @brief (a & b).any()
+     */
+    friend inline bool intersects(const dynamic_bitset& a, const dynamic_bitset& b) noexcept
+    {
+        const auto a_words_ = a.blocks_words_();
+        const auto b_words_ = b.blocks_words_();
+        return detail::dynamic_bitset::any<bit_op::AND>(
+            a.m_words, b.m_words, a_words_ < b_words_ ? a_words_ : b_words_);
+    }
+
+    friend inline bool operator==(const dynamic_bitset& lhs, const dynamic_bitset& rhs) noexcept
+    {
+        return lhs.m_bits == rhs.m_bits &&
+            !detail::dynamic_bitset::any<bit_op::XOR>(
+                lhs.m_words, rhs.m_words, lhs.blocks_words_());
+    }
+    friend inline bool operator!=(const dynamic_bitset& lhs, const dynamic_bitset& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+inline dynamic_bitset operator&(dynamic_bitset lhs, const dynamic_bitset& rhs) noexcept
+{
+    lhs &= rhs;
+    return lhs;
+}
+inline dynamic_bitset operator|(dynamic_bitset lhs, const dynamic_bitset& rhs) noexcept
+{
+    lhs |= rhs;
+    return lhs;
+}
+inline dynamic_bitset operator^(dynamic_bitset lhs, const dynamic_bitset& rhs) noexcept
+{
+    lhs ^= rhs;
+    return lhs;
+}
+
+inline void swap(dynamic_bitset& lhs, dynamic_bitset& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace containers
+
+using dynamic_bitset_t = containers::dynamic_bitset;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_DYNAMIC_BITSET_HPP_ */
@@ -0,0 +1,1264 @@
+#ifndef ECSL_CONTAINERS_FLAT_HASH_MAP_HPP_
+#define ECSL_CONTAINERS_FLAT_HASH_MAP_HPP_
+
+/**
+ * @file FlatHashMap.hpp
+ * Declares open addressing hash map and set with SIMD probing of control bytes
+ *
+ * Layout (Swiss table): elements live in a flat array of slots split into
+ * groups of 16, every slot has a control byte - EMPTY, DELETED or the low
+ * 7 bits of the hash (H2) of its element. A lookup starts at the group
+ * chosen by the high bits of the hash (H1), compares 16 control bytes with
+ * H2 in one SSE2/NEON instruction, checks the keys of the matching slots
+ * only and stops at the first group with an EMPTY slot. Groups are probed
+ * in triangular order, which visits every group of a power of two table.
+ * Maximum load factor is 7/8.
+ *
+ * Erase leaves no tombstone when the group of the slot has an EMPTY one:
+ * no probe sequence ever passed such group (it was never full since the
+ * last rehash), so the slot may become EMPTY again. Otherwise the slot is
+ * DELETED and is reused by inserts, and a table without growth left that
+ * is at most half full is rehashed in place of growing.
+ *
+ * Heterogeneous lookup (find, contains, count, erase, at) is enabled when
+ * both Hash and KeyEqual define is_transparent.
+ * Any insert may rehash and invalidate iterators and references.
+ *
+ * Sources:
+ *  M. Kulukundis "Designing a Fast, Efficient, Cache-friendly Hash Table,
+ *  Step by Step" CppCon 2017
+ *  https://abseil.io/about/design/swisstables
+ */
+
+/// STD
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+/// ECSL
+#include <ecsl/containers/MinimalBitset.hpp>
+#include <ecsl/containers/detail/ValueTrait.hpp>
+#include <ecsl/platform/Simd.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace flat_hash {
+
+using ctrl_t = signed char;
+
+constexpr ctrl_t EMPTY = -128;
+constexpr ctrl_t DELETED = -2;
+//? Stops iteration past the last slot
+constexpr ctrl_t SENTINEL = -1;
+
+constexpr std::size_t GROUP_SIZE = 16;
+constexpr std::size_t H2_BITS = 7;
+
+/**
+ * Spreads the entropy of the hash over all bits (identity std::hash of
+ * integers would leave H2 equal to the low bits of the key)
+ */
+inline std::size_t mix(std::size_t hash) noexcept
+{
+    std::uint64_t h_ = static_cast<std::uint64_t>(hash);
+    h_ ^= h_ >> 33;
+    h_ *= 0xFF51AFD7ED558CCDull;
+    h_ ^= h_ >> 33;
+    return static_cast<std::size_t>(h_);
+}
+
+/**
+ * Set of slot positions inside of a group, one bit (or nibble) per slot
+ */
+struct bitmask
+{
+#if defined(ECSL_SIMD_NEON) && !defined(ECSL_SIMD_SSE2)
+    static constexpr std::size_t SHIFT = 2;
+#else
+    static constexpr std::size_t SHIFT = 0;
+#endif
+
+    std::uint64_t m_bits;
+
+    explicit operator bool() const noexcept { return m_bits != 0; }
+
+    inline std::size_t lowest() const noexcept
+    {
+        return minimal_bitset::lowest_bit_(m_bits) >> SHIFT;
+    }
+
+    inline bitmask next() const noexcept
+    {
+        return {m_bits & (m_bits - 1)};
+    }
+};
+
+/**
+ * Control bytes of 16 consecutive slots
+ */
+struct group
+{
+#if defined(ECSL_SIMD_SSE2)
+
+    __m128i m_ctrl;
+
+    explicit group(const ctrl_t* ctrl) noexcept :
+        m_ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))}
+    {}
+
+    inline bitmask match(ctrl_t h2) const noexcept
+    {
+        return {static_cast<std::uint64_t>(static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl))))};
+    }
+
+    inline bitmask mask_empty_or_deleted() const noexcept
+    {
+        return {static_cast<std::uint64_t>(static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(SENTINEL), m_ctrl))))};
+    }
+
+    inline bitmask mask_full_or_sentinel() const noexcept
+    {
+        return {static_cast<std::uint64_t>(static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(m_ctrl, _mm_set1_epi8(DELETED)))))};
+    }
+
+#elif defined(ECSL_SIMD_NEON)
+
+    int8x16_t m_ctrl;
+
+    explicit group(const ctrl_t* ctrl) noexcept :
+        m_ctrl{vld1q_s8(reinterpret_cast<const std::int8_t*>(ctrl))}
+    {}
+
+    /**
+     * Byte mask to the nibble mask (there is no movemask in NEON)
+     */
+    static inline std::uint64_t to_mask_(uint8x16_t v) noexcept
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(
+            vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0) & 0x8888888888888888ull;
+    }
+
+    inline bitmask match(ctrl_t h2) const noexcept
+    {
+        return {to_mask_(vceqq_s8(m_ctrl, vdupq_n_s8(h2)))};
+    }
+
+    inline bitmask mask_empty_or_deleted() const noexcept
+    {
+        return {to_mask_(vcltq_s8(m_ctrl, vdupq_n_s8(SENTINEL)))};
+    }
+
+    inline bitmask mask_full_or_sentinel() const noexcept
+    {
+        return {to_mask_(vcgtq_s8(m_ctrl, vdupq_n_s8(DELETED)))};
+    }
+
+#else
+
+    ctrl_t m_ctrl[GROUP_SIZE];
+
+    explicit group(const ctrl_t* ctrl) noexcept
+    {
+        std::memcpy(m_ctrl, ctrl, GROUP_SIZE);
+    }
+
+    inline bitmask match(ctrl_t h2) const noexcept
+    {
+        std::uint64_t r_{0};
+        for (std::size_t i{0}; i < GROUP_SIZE; ++i)
+        {
+            r_ |= static_cast<std::uint64_t>(m_ctrl[i] == h2) << i;
+        }
+        return {r_};
+    }
+
+    inline bitmask mask_empty_or_deleted() const noexcept
+    {
+        std::uint64_t r_{0};
+        for (std::size_t i{0}; i < GROUP_SIZE; ++i)
+        {
+            r_ |= static_cast<std::uint64_t>(m_ctrl[i] < SENTINEL) << i;
+        }
+        return {r_};
+    }
+
+    inline bitmask mask_full_or_sentinel() const noexcept
+    {
+        std::uint64_t r_{0};
+        for (std::size_t i{0}; i < GROUP_SIZE; ++i)
+        {
+            r_ |= static_cast<std::uint64_t>(m_ctrl[i] > DELETED) << i;
+        }
+        return {r_};
+    }
+
+#endif
+
+    inline bitmask mask_empty() const noexcept
+    {
+        return match(EMPTY);
+    }
+};
+
+struct alignas(GROUP_SIZE) ctrl_block
+{
+    ctrl_t m_bytes[GROUP_SIZE];
+};
+
+struct tables
+{
+    /**
+     * Control bytes of the table without slots: lookups end in the first
+     * group
+     */
+    static constexpr ctrl_block EMPTY_GROUP = {{
+        EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
+        EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY}};
+};
+
+/**
+ * Least power of two count of slots able to hold count elements at 7/8 load
+ */
+inline std::size_t capacity_for(std::size_t count) noexcept
+{
+    std::size_t r_{GROUP_SIZE};
+    while (r_ - r_ / 8 < count)
+    {
+        r_ <<= 1;
+    }
+    return r_;
+}
+
+/**
+ * key_arg<K> is K for transparent Hash and KeyEqual and key_type otherwise
+ */
+template<bool TRANSPARENT>
+struct key_arg
+{
+    template<class K, class Key>
+    using type = Key;
+};
+
+template<>
+struct key_arg<true>
+{
+    template<class K, class Key>
+    using type = K;
+};
+
+template<class T, class = void>
+struct is_transparent : std::false_type {};
+
+template<class T>
+struct is_transparent<T, std::void_t<typename T::is_transparent>> :
+    std::true_type
+{};
+
+/**
+ * Elements of the set: the key itself
+ */
+template<class K>
+struct set_policy
+{
+    using key_type          = K;
+    using value_type        = K;
+    using slot_type         = K;
+    using reference         = const K&;
+
+    static inline const K& key(const slot_type* slot) noexcept { return *slot; }
+    static inline const K& element(const slot_type* slot) noexcept { return *slot; }
+
+    template<class ... Args>
+    static inline void construct(slot_type* slot, Args&& ... args)
+    {
+        ::new(static_cast<void*>(slot)) K(std::forward<Args>(args)...);
+    }
+
+    static inline void destroy(slot_type* slot) noexcept
+    {
+        slot->~K();
+    }
+
+    /**
+     * Moves the element to uninitialized dst, src is left destroyed
+     */
+    static inline void transfer(slot_type* dst, slot_type* src)
+    {
+        if constexpr (is_trivially_relocatable<K>::value)
+        {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(K));
+        }
+        else
+        {
+            ::new(static_cast<void*>(dst)) K(std::move(*src));
+            src->~K();
+        }
+    }
+};
+
+/**
+ * Slot of the map: the key of std::pair<const K, V> is moved on rehash
+ * through the layout compatible std::pair<K, V> member
+ */
+template<class K, class V>
+union map_slot
+{
+    map_slot() noexcept {}
+    ~map_slot() {}
+
+    std::pair<const K, V> m_value;
+    std::pair<K, V> m_mutable;
+};
+
+template<class K, class V>
+struct map_policy
+{
+    using key_type          = K;
+    using mapped_type       = V;
+    using value_type        = std::pair<const K, V>;
+    using slot_type         = map_slot<K, V>;
+    using reference         = value_type&;
+
+    static inline const K& key(const slot_type* slot) noexcept { return slot->m_value.first; }
+    static inline value_type& element(slot_type* slot) noexcept { return slot->m_value; }
+    static inline const value_type& element(const slot_type* slot) noexcept { return slot->m_value; }
+
+    template<class ... Args>
+    static inline void construct(slot_type* slot, Args&& ... args)
+    {
+        ::new(static_cast<void*>(&slot->m_value)) value_type(std::forward<Args>(args)...);
+    }
+
+    static inline void destroy(slot_type* slot) noexcept
+    {
+        slot->m_value.~value_type();
+    }
+
+    static inline void transfer(slot_type* dst, slot_type* src)
+    {
+        if constexpr (is_trivially_relocatable<value_type>::value)
+        {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(slot_type));
+        }
+        else
+        {
+            ::new(static_cast<void*>(&dst->m_mutable)) std::pair<K, V>(std::move(src->m_mutable));
+            src->m_mutable.~pair();
+        }
+    }
+};
+
+/**
+ * Table shared by flat_hash_set and flat_hash_map
+ */
+template<class Policy, class Hash, class KeyEqual>
+class raw_table
+{
+  protected:
+    using slot_type = typename Policy::slot_type;
+
+    template<class K>
+    using key_arg_t = typename key_arg<
+        is_transparent<Hash>::value && is_transparent<KeyEqual>::value
+    >::template type<K, typename Policy::key_type>;
+
+  public:
+    using key_type          = typename Policy::key_type;
+    using value_type        = typename Policy::value_type;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+    using hasher            = Hash;
+    using key_equal         = KeyEqual;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+
+    template<bool CONST>
+    class iterator_
+    {
+        friend class raw_table;
+
+      public:
+        using value_type        = typename Policy::value_type;
+        using reference         = typename std::conditional<CONST,
+            const value_type&, typename Policy::reference>::type;
+        using pointer           = typename std::remove_reference<reference>::type*;
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+
+      private:
+        using slot_pointer = typename std::conditional<CONST, const slot_type*, slot_type*>::type;
+
+        const ctrl_t* m_ctrl;
+        slot_pointer m_slot;
+
+        iterator_(const ctrl_t* ctrl, slot_pointer slot) noexcept : m_ctrl{ctrl}, m_slot{slot} {}
+
+        /**
+         * Moves to the first full slot at or after the current one
+         */
+        void skip_() noexcept
+        {
+            //? The sentinel after the last slot stops the loop
+            for (;;)
+            {
+                if (const auto used_ = group{m_ctrl}.mask_full_or_sentinel())
+                {
+                    m_ctrl += used_.lowest();
+                    m_slot += used_.lowest();
+                    return;
+                }
+                m_ctrl += GROUP_SIZE;
+                m_slot += GROUP_SIZE;
+            }
+        }
+
+      public:
+        iterator_() noexcept : m_ctrl{nullptr}, m_slot{nullptr} {}
+
+        template<bool C = CONST, class = typename std::enable_if<C>::type>
+        iterator_(const iterator_<false>& other) noexcept :
+            m_ctrl{other.m_ctrl}, m_slot{other.m_slot}
+        {}
+
+        reference operator*() const noexcept { return Policy::element(m_slot); }
+        pointer operator->() const noexcept { return &Policy::element(m_slot); }
+
+        iterator_& operator++() noexcept
+        {
+            ++m_ctrl;
+            ++m_slot;
+            skip_();
+            return *this;
+        }
+
+        iterator_ operator++(int) noexcept
+        {
+            iterator_ old{*this};
+            ++(*this);
+            return old;
+        }
+
+        friend bool operator==(const iterator_& lhs, const iterator_& rhs) noexcept
+        {
+            return lhs.m_ctrl == rhs.m_ctrl;
+        }
+
+        friend bool operator!=(const iterator_& lhs, const iterator_& rhs) noexcept
+        {
+            return lhs.m_ctrl != rhs.m_ctrl;
+        }
+
+        friend class iterator_<!CONST>;
+    };
+
+    using iterator          = iterator_<std::is_const<
+        typename std::remove_reference<typename Policy::reference>::type>::value>;
+    using const_iterator    = iterator_<true>;
+
+  protected:
+    static constexpr size_type NOT_FOUND = ~size_type{0};
+
+    ctrl_t* m_ctrl;
+    slot_type* m_slots;
+    size_type m_capacity;
+    size_type m_size;
+    size_type m_growth_left;
+    hasher m_hash;
+    key_equal m_equal;
+
+    static inline size_type max_load_(size_type capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    inline size_type group_mask_() const noexcept
+    {
+        return m_capacity ? m_capacity / GROUP_SIZE - 1 : 0;
+    }
+
+    template<class K>
+    inline size_type hash_(const K& key) const
+    {
+        return mix(m_hash(key));
+    }
+
+    static inline ctrl_t h2_(size_type hash) noexcept
+    {
+        return static_cast<ctrl_t>(hash & ((size_type{1} << H2_BITS) - 1));
+    }
+
+    /**
+     * Index of the slot holding key or NOT_FOUND
+     */
+    template<class K>
+    size_type find_index_(const K& key, size_type hash) const
+    {
+        const auto h2_value_ = h2_(hash);
+        const auto mask_ = group_mask_();
+        auto g_ = (hash >> H2_BITS) & mask_;
+        for (size_type step_{1};; ++step_)
+        {
+            const group group_{m_ctrl + g_ * GROUP_SIZE};
+            for (auto m_ = group_.match(h2_value_); m_; m_ = m_.next())
+            {
+                const auto index_ = g_ * GROUP_SIZE + m_.lowest();
+                if (m_equal(Policy::key(m_slots + index_), key))
+                {
+                    return index_;
+                }
+            }
+            if (group_.mask_empty())
+            {
+                return NOT_FOUND;
+            }
+            g_ = (g_ + step_) & mask_;
+        }
+    }
+
+    /**
+     * Index of the first EMPTY or DELETED slot on the probe sequence
+     */
+    size_type find_free_(size_type hash) const noexcept
+    {
+        const auto mask_ = group_mask_();
+        auto g_ = (hash >> H2_BITS) & mask_;
+        for (size_type step_{1};; ++step_)
+        {
+            if (const auto free_ = group{m_ctrl + g_ * GROUP_SIZE}.mask_empty_or_deleted())
+            {
+                return g_ * GROUP_SIZE + free_.lowest();
+            }
+            g_ = (g_ + step_) & mask_;
+        }
+    }
+
+    /**
+     * Allocates EMPTY table of capacity slots (a power of two >= 16)
+     */
+    void allocate_(size_type capacity)
+    {
+        const auto blocks_ = capacity / GROUP_SIZE + 1;
+        auto* blocks_ptr_ = std::allocator<ctrl_block>{}.allocate(blocks_);
+        try
+        {
+            m_slots = std::allocator<slot_type>{}.allocate(capacity);
+        }
+        catch (...)
+        {
+            std::allocator<ctrl_block>{}.deallocate(blocks_ptr_, blocks_);
+            throw;
+        }
+        m_ctrl = blocks_ptr_->m_bytes;
+        std::memset(m_ctrl, static_cast<unsigned char>(EMPTY), capacity);
+        std::memset(m_ctrl + capacity, static_cast<unsigned char>(SENTINEL), GROUP_SIZE);
+        m_capacity = capacity;
+        m_growth_left = max_load_(capacity) - m_size;
+    }
+
+    /**
+     * Frees the storage (elements must be destroyed or transferred)
+     */
+    void deallocate_() noexcept
+    {
+        if (m_capacity)
+        {
+            std::allocator<ctrl_block>{}.deallocate(
+                reinterpret_cast<ctrl_block*>(m_ctrl), m_capacity / GROUP_SIZE + 1);
+            std::allocator<slot_type>{}.deallocate(m_slots, m_capacity);
+        }
+        reset_();
+    }
+
+    void reset_() noexcept
+    {
+        m_ctrl = const_cast<ctrl_t*>(tables::EMPTY_GROUP.m_bytes);
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growth_left = 0;
+    }
+
+    void destroy_all_() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<value_type>::value)
+        {
+            for (size_type i{0}; i < m_capacity; ++i)
+            {
+                if (m_ctrl[i] >= 0)
+                {
+                    Policy::destroy(m_slots + i);
+                }
+            }
+        }
+    }
+
+    /**
+     * Moves the elements to a new table of capacity slots
+     */
+    void resize_(size_type capacity)
+    {
+        auto* old_ctrl_ = m_ctrl;
+        auto* old_slots_ = m_slots;
+        const auto old_capacity_ = m_capacity;
+        allocate_(capacity);
+        for (size_type i{0}; i < old_capacity_; ++i)
+        {
+            if (old_ctrl_[i] >= 0)
+            {
+                const auto hash_value_ = hash_(Policy::key(old_slots_ + i));
+                const auto index_ = find_free_(hash_value_);
+                m_ctrl[index_] = h2_(hash_value_);
+                Policy::transfer(m_slots + index_, old_slots_ + i);
+            }
+        }
+        m_growth_left = max_load_(m_capacity) - m_size;
+        if (old_capacity_)
+        {
+            std::allocator<ctrl_block>{}.deallocate(
+                reinterpret_cast<ctrl_block*>(old_ctrl_), old_capacity_ / GROUP_SIZE + 1);
+            std::allocator<slot_type>{}.deallocate(old_slots_, old_capacity_);
+        }
+    }
+
+    /**
+     * Makes room for one more element: drops tombstones or grows
+     */
+    void rehash_and_grow_()
+    {
+        if (m_capacity && m_size <= max_load_(m_capacity) / 2)
+        {
+            resize_(m_capacity);
+        }
+        else
+        {
+            resize_(m_capacity ? m_capacity * 2 : GROUP_SIZE);
+        }
+    }
+
+    /**
+     * Index of key or of the slot prepared for it
+     * @return {index, true} if the slot is new (the element must be constructed)
+     */
+    template<class K>
+    std::pair<size_type, bool> find_or_prepare_insert_(const K& key, size_type hash_value_)
+    {
+        const auto found_ = find_index_(key, hash_value_);
+        if (found_ != NOT_FOUND)
+        {
+            return {found_, false};
+        }
+        auto index_ = find_free_(hash_value_);
+        if (m_growth_left == 0 && m_ctrl[index_] != DELETED)
+        {
+            rehash_and_grow_();
+            index_ = find_free_(hash_value_);
+        }
+        return {index_, true};
+    }
+
+    /**
+     * Marks the prepared slot as used (after the element is constructed)
+     */
+    inline void commit_insert_(size_type index, size_type hash) noexcept
+    {
+        m_growth_left -= m_ctrl[index] == EMPTY;
+        m_ctrl[index] = h2_(hash);
+        ++m_size;
+    }
+
+    /**
+     * Constructs the element for key in the prepared slot
+     */
+    template<class K, class ... Args>
+    std::pair<iterator, bool> emplace_key_(const K& key, Args&& ... args)
+    {
+        const auto hash_value_ = hash_(key);
+        const auto r_ = find_or_prepare_insert_(key, hash_value_);
+        if (r_.second)
+        {
+            Policy::construct(m_slots + r_.first, std::forward<Args>(args)...);
+            commit_insert_(r_.first, hash_value_);
+        }
+        return {iterator_at_(r_.first), r_.second};
+    }
+
+    void erase_index_(size_type index) noexcept
+    {
+        Policy::destroy(m_slots + index);
+        --m_size;
+        const group group_{m_ctrl + index / GROUP_SIZE * GROUP_SIZE};
+        //? A group with an EMPTY slot never stopped a probe
+        if (group_.mask_empty())
+        {
+            m_ctrl[index] = EMPTY;
+            ++m_growth_left;
+        }
+        else
+        {
+            m_ctrl[index] = DELETED;
+        }
+    }
+
+    inline iterator iterator_at_(size_type index) noexcept
+    {
+        return {m_ctrl + index, m_slots + index};
+    }
+
+    inline const_iterator iterator_at_(size_type index) const noexcept
+    {
+        return {m_ctrl + index, m_slots + index};
+    }
+
+    template<class It>
+    inline size_type index_of_(It position) const noexcept
+    {
+        return static_cast<size_type>(position.m_ctrl - m_ctrl);
+    }
+
+    void copy_from_(const raw_table& other)
+    {
+        reserve(other.m_size);
+        for (size_type i{0}; i < other.m_capacity; ++i)
+        {
+            if (other.m_ctrl[i] >= 0)
+            {   //? Keys are unique: no lookup, only a free slot
+                const auto hash_value_ = hash_(Policy::key(other.m_slots + i));
+                const auto index_ = find_free_(hash_value_);
+                Policy::construct(m_slots + index_, Policy::element(other.m_slots + i));
+                commit_insert_(index_, hash_value_);
+            }
+        }
+    }
+
+    void steal_(raw_table& other) noexcept
+    {
+        m_ctrl = other.m_ctrl;
+        m_slots = other.m_slots;
+        m_capacity = other.m_capacity;
+        m_size = other.m_size;
+        m_growth_left = other.m_growth_left;
+        other.reset_();
+    }
+
+  public:
+    raw_table() noexcept(std::is_nothrow_default_constructible<hasher>::value &&
+        std::is_nothrow_default_constructible<key_equal>::value) :
+        m_hash{}, m_equal{}
+    {
+        reset_();
+    }
+
+    explicit raw_table(size_type count, const hasher& hash = hasher{},
+        const key_equal& equal = key_equal{}) :
+        m_hash{hash}, m_equal{equal}
+    {
+        reset_();
+        reserve(count);
+    }
+
+    raw_table(const raw_table& other) :
+        m_hash{other.m_hash}, m_equal{other.m_equal}
+    {
+        reset_();
+        try
+        {
+            copy_from_(other);
+        }
+        catch (...)
+        {
+            clear();
+            deallocate_();
+            throw;
+        }
+    }
+
+    raw_table(raw_table&& other) noexcept :
+        m_hash{std::move(other.m_hash)}, m_equal{std::move(other.m_equal)}
+    {
+        steal_(other);
+    }
+
+    raw_table& operator=(const raw_table& other)
+    {
+        if (this != &other)
+        {
+            raw_table tmp_{other};
+            swap(tmp_);
+        }
+        return *this;
+    }
+
+    raw_table& operator=(raw_table&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy_all_();
+            deallocate_();
+            m_hash = std::move(other.m_hash);
+            m_equal = std::move(other.m_equal);
+            steal_(other);
+        }
+        return *this;
+    }
+
+    ~raw_table()
+    {
+        destroy_all_();
+        deallocate_();
+    }
+
+    /* Iterators */
+
+    iterator begin() noexcept
+    {
+        if (!m_size)
+        {
+            return end();
+        }
+        iterator it_{m_ctrl, m_slots};
+        it_.skip_();
+        return it_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        if (!m_size)
+        {
+            return end();
+        }
+        const_iterator it_{m_ctrl, m_slots};
+        it_.skip_();
+        return it_;
+    }
+
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline iterator end() noexcept { return iterator_at_(m_capacity); }
+    inline const_iterator end() const noexcept { return iterator_at_(m_capacity); }
+    inline const_iterator cend() const noexcept { return end(); }
+
+    /* Capacity */
+
+    inline size_type size() const noexcept { return m_size; }
+    inline bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief Count of slots
+     */
+    inline size_type capacity() const noexcept { return m_capacity; }
+
+    inline float load_factor() const noexcept
+    {
+        return m_capacity ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.0f;
+    }
+
+    static constexpr float max_load_factor() noexcept { return 0.875f; }
+
+    /**
+     * @brief Makes room for count elements without rehash (drops tombstones)
+     */
+    void reserve(size_type count)
+    {
+        if (count > m_size + m_growth_left)
+        {
+            resize_(capacity_for(count));
+        }
+    }
+
+    /**
+     * @brief Rebuilds the table for at least max(count, size()) elements
+     * rehash(0) shrinks the table to fit and frees the storage of empty one.
+     */
+    void rehash(size_type count)
+    {
+        if (count == 0 && m_size == 0)
+        {
+            return deallocate_();
+        }
+        resize_(capacity_for(count > m_size ? count : m_size));
+    }
+
+    /**
+     * @brief Destroys the elements, the storage is kept
+     */
+    void clear() noexcept
+    {
+        destroy_all_();
+        m_size = 0;
+        if (m_capacity)
+        {
+            std::memset(m_ctrl, static_cast<unsigned char>(EMPTY), m_capacity);
+            m_growth_left = max_load_(m_capacity);
+        }
+    }
+
+    /* Lookup */
+
+    template<class K = key_type>
+    iterator find(const key_arg_t<K>& key)
+    {
+        const auto index_ = find_index_(key, hash_(key));
+        return index_ == NOT_FOUND ? end() : iterator_at_(index_);
+    }
+
+    template<class K = key_type>
+    const_iterator find(const key_arg_t<K>& key) const
+    {
+        const auto index_ = find_index_(key, hash_(key));
+        return index_ == NOT_FOUND ? end() : iterator_at_(index_);
+    }
+
+    template<class K = key_type>
+    bool contains(const key_arg_t<K>& key) const
+    {
+        return find_index_(key, hash_(key)) != NOT_FOUND;
+    }
+
+    template<class K = key_type>
+    size_type count(const key_arg_t<K>& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /* Erase */
+
+    /**
+     * @return Iterator following the erased element
+     */
+    iterator erase(const_iterator position) noexcept
+    {
+        const auto index_ = index_of_(position);
+        erase_index_(index_);
+        iterator it_ = iterator_at_(index_);
+        ++it_;
+        return it_;
+    }
+
+    template<class It = iterator, class = typename std::enable_if<
+        !std::is_same<It, const_iterator>::value>::type>
+    iterator erase(iterator position) noexcept
+    {
+        return erase(const_iterator{position});
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept
+    {
+        while (first != last)
+        {
+            first = erase(first);
+        }
+        return iterator_at_(index_of_(last));
+    }
+
+    template<class K = key_type>
+    size_type erase(const key_arg_t<K>& key)
+    {
+        const auto index_ = find_index_(key, hash_(key));
+        if (index_ == NOT_FOUND)
+        {
+            return 0;
+        }
+        erase_index_(index_);
+        return 1;
+    }
+
+    void swap(raw_table& other) noexcept
+    {
+        using std::swap;
+        swap(m_ctrl, other.m_ctrl);
+        swap(m_slots, other.m_slots);
+        swap(m_capacity, other.m_capacity);
+        swap(m_size, other.m_size);
+        swap(m_growth_left, other.m_growth_left);
+        swap(m_hash, other.m_hash);
+        swap(m_equal, other.m_equal);
+    }
+
+    inline hasher hash_function() const { return m_hash; }
+    inline key_equal key_eq() const { return m_equal; }
+};
+
+} // namespace flat_hash
+} // namespace detail
+
+/**
+ * @brief Open addressing hash set, see the file description
+ */
+template<class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class flat_hash_set :
+    public detail::flat_hash::raw_table<detail::flat_hash::set_policy<Key>, Hash, KeyEqual>
+{
+    using base_t = detail::flat_hash::raw_table<detail::flat_hash::set_policy<Key>, Hash, KeyEqual>;
+
+  public:
+    using typename base_t::key_type;
+    using typename base_t::value_type;
+    using typename base_t::size_type;
+    using typename base_t::hasher;
+    using typename base_t::key_equal;
+    using typename base_t::iterator;
+    using typename base_t::const_iterator;
+
+    using base_t::base_t;
+
+    flat_hash_set() = default;
+
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    flat_hash_set(InputIt first, InputIt last, size_type count = 0) : base_t(count)
+    {
+        insert(first, last);
+    }
+
+    flat_hash_set(std::initializer_list<value_type> init) : base_t(init.size())
+    {
+        insert(init.begin(), init.end());
+    }
+
+    inline std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return this->emplace_key_(value, value);
+    }
+
+    inline std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return this->emplace_key_(value, std::move(value));
+    }
+
+    template<class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(*first);
+        }
+    }
+
+    inline void insert(std::initializer_list<value_type> init)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    template<class ... Args>
+    std::pair<iterator, bool> emplace(Args&& ... args)
+    {
+        value_type value_(std::forward<Args>(args)...);
+        return insert(std::move(value_));
+    }
+
+    friend bool operator==(const flat_hash_set& lhs, const flat_hash_set& rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        for (const auto& value : lhs)
+        {
+            if (!rhs.contains(value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const flat_hash_set& lhs, const flat_hash_set& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend void swap(flat_hash_set& lhs, flat_hash_set& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+};
+
+/**
+ * @brief Open addressing hash map, see the file description
+ * Elements are std::pair<const Key, T>, prefer try_emplace over emplace:
+ * the latter constructs the pair before the lookup.
+ */
+template<class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class flat_hash_map :
+    public detail::flat_hash::raw_table<detail::flat_hash::map_policy<Key, T>, Hash, KeyEqual>
+{
+    using base_t = detail::flat_hash::raw_table<detail::flat_hash::map_policy<Key, T>, Hash, KeyEqual>;
+
+    template<class K>
+    using key_arg_t = typename base_t::template key_arg_t<K>;
+
+  public:
+    using typename base_t::key_type;
+    using typename base_t::value_type;
+    using typename base_t::size_type;
+    using typename base_t::hasher;
+    using typename base_t::key_equal;
+    using typename base_t::iterator;
+    using typename base_t::const_iterator;
+    using mapped_type = T;
+
+    using base_t::base_t;
+
+    flat_hash_map() = default;
+
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    flat_hash_map(InputIt first, InputIt last, size_type count = 0) : base_t(count)
+    {
+        insert(first, last);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> init) : base_t(init.size())
+    {
+        insert(init.begin(), init.end());
+    }
+
+    /* Insert */
+
+    template<class ... Args>
+    inline std::pair<iterator, bool> try_emplace(const key_type& key, Args&& ... args)
+    {
+        return this->emplace_key_(key, std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template<class ... Args>
+    inline std::pair<iterator, bool> try_emplace(key_type&& key, Args&& ... args)
+    {
+        return this->emplace_key_(key, std::piecewise_construct,
+            std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    inline std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return this->emplace_key_(value.first, value);
+    }
+
+    inline std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return this->emplace_key_(value.first, std::move(value));
+    }
+
+    template<class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(*first);
+        }
+    }
+
+    inline void insert(std::initializer_list<value_type> init)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value)
+    {
+        auto r_ = try_emplace(key, std::forward<M>(value));
+        if (!r_.second)
+        {
+            r_.first->second = std::forward<M>(value);
+        }
+        return r_;
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& value)
+    {
+        auto r_ = try_emplace(std::move(key), std::forward<M>(value));
+        if (!r_.second)
+        {
+            r_.first->second = std::forward<M>(value);
+        }
+        return r_;
+    }
+
+    template<class ... Args>
+    std::pair<iterator, bool> emplace(Args&& ... args)
+    {
+        value_type value_(std::forward<Args>(args)...);
+        return insert(std::move(value_));
+    }
+
+    /* Access */
+
+    inline mapped_type& operator[](const key_type& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    inline mapped_type& operator[](key_type&& key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    template<class K = key_type>
+    mapped_type& at(const key_arg_t<K>& key)
+    {
+        const auto it_ = this->find(key);
+        if (it_ == this->end())
+        {
+            throw std::out_of_range{"flat_hash_map range check failed"};
+        }
+        return it_->second;
+    }
+
+    template<class K = key_type>
+    const mapped_type& at(const key_arg_t<K>& key) const
+    {
+        const auto it_ = this->find(key);
+        if (it_ == this->end())
+        {
+            throw std::out_of_range{"flat_hash_map range check failed"};
+        }
+        return it_->second;
+    }
+
+    friend bool operator==(const flat_hash_map& lhs, const flat_hash_map& rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        for (const auto& value : lhs)
+        {
+            const auto it_ = rhs.find(value.first);
+            if (it_ == rhs.end() || !(it_->second == value.second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const flat_hash_map& lhs, const flat_hash_map& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+};
+
+} // namespace containers
+
+template<class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+using flat_hash_set_t = containers::flat_hash_set<Key, Hash, KeyEqual>;
+
+template<class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+using flat_hash_map_t = containers::flat_hash_map<Key, T, Hash, KeyEqual>;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_FLAT_HASH_MAP_HPP_ */
@@ -0,0 +1,246 @@
+#ifndef ECSL_CONTAINERS_HIERARCHICAL_BITSET_HPP_
+#define ECSL_CONTAINERS_HIERARCHICAL_BITSET_HPP_
+
+/**
+ * @file HierarchicalBitset.hpp
+ * Declares run time sized bit vector with summary levels for fast search
+ * over large sparse universes
+ *
+ * Level 0 holds the bits, every next level holds one bit per word of the
+ * level below which is set if and only if that word is non-zero. The top
+ * level is a single word. So set, reset, find_first and find_next touch at
+ * most one word per level: ceil(log64(size())) words, 4 for 16M bits.
+ * Typical uses: timer wheels (set bit = occupied slot) and free-page maps
+ * (set bit = free page, find_first claims the lowest free page).
+ */
+
+/// STD
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+/// ECSL
+#include <ecsl/containers/MinimalBitset.hpp>
+
+namespace ecsl {
+namespace containers {
+
+/**
+ * @brief Fixed size (set at construction) bit vector with O(log64 n) search
+ */
+class hierarchical_bitset
+{
+  public:
+    using word_type     = std::uint64_t;
+    using size_type     = std::size_t;
+
+    static constexpr size_type BITS_IN_WORD = sizeof(word_type) * CHAR_BIT;
+    //? 64^11 > 2^64
+    static constexpr size_type MAX_LEVELS = 11;
+
+  private:
+    std::vector<word_type> m_words;
+    size_type m_bits;
+    size_type m_levels;
+    //? Level i occupies words [m_offsets[i], m_offsets[i+1])
+    size_type m_offsets[MAX_LEVELS + 1];
+
+    static constexpr word_type bit_mask_(size_type position) noexcept
+    {
+        return word_type{1} << (position % BITS_IN_WORD);
+    }
+
+    inline word_type& word_(size_type level, size_type position) noexcept
+    {
+        return m_words[m_offsets[level] + position / BITS_IN_WORD];
+    }
+
+    inline word_type word_(size_type level, size_type position) const noexcept
+    {
+        return m_words[m_offsets[level] + position / BITS_IN_WORD];
+    }
+
+    /**
+     * Count of bits (words of the level below) at level
+     */
+    inline size_type level_bits_(size_type level) const noexcept
+    {
+        return level ? m_offsets[level] - m_offsets[level - 1] : m_bits;
+    }
+
+    /**
+     * First set bit at or after position or size()
+     */
+    size_type find_from_(size_type position) const noexcept
+    {
+        if (position >= m_bits)
+        {
+            return m_bits;
+        }
+        size_type level_{0};
+        //? Climb while the rest of the current word is empty
+        for (;;)
+        {
+            const auto bits_ = word_(level_, position) &
+                (~word_type{0} << (position % BITS_IN_WORD));
+            if (bits_)
+            {
+                position = position / BITS_IN_WORD * BITS_IN_WORD +
+                    detail::minimal_bitset::lowest_bit_(bits_);
+                break;
+            }
+            //? Next word of this level is the next bit of the upper level
+            position = position / BITS_IN_WORD + 1;
+            if (++level_ == m_levels || position >= level_bits_(level_))
+            {
+                return m_bits;
+            }
+        }
+        //? Descend through the first non-empty words
+        while (level_-- > 0)
+        {
+            position = position * BITS_IN_WORD +
+                detail::minimal_bitset::lowest_bit_(word_(level_, position * BITS_IN_WORD));
+        }
+        return position;
+    }
+
+  public:
+    explicit hierarchical_bitset(size_type bits) :
+        m_bits{bits}, m_levels{0}, m_offsets{}
+    {
+        size_type words_ = (bits + BITS_IN_WORD - 1) / BITS_IN_WORD;
+        size_type total_{0};
+        do
+        {
+            words_ = words_ ? words_ : 1;
+            m_offsets[m_levels++] = total_;
+            total_ += words_;
+            words_ = (words_ + BITS_IN_WORD - 1) / BITS_IN_WORD;
+        }
+        while (m_offsets[m_levels - 1] + 1 != total_);
+        m_offsets[m_levels] = total_;
+        m_words.assign(total_, 0);
+    }
+
+    inline size_type size() const noexcept { return m_bits; }
+
+    /**
+     * @brief Count of summary levels including the bit level
+     */
+    inline size_type levels() const noexcept { return m_levels; }
+
+    /* Single bit access: out of range positions are ignored */
+
+    inline bool test(size_type position) const noexcept
+    {
+        return position < m_bits && (word_(0, position) & bit_mask_(position));
+    }
+
+    bool at(size_type position) const
+    {
+        if (position < m_bits)
+        {
+            return test(position);
+        }
+        throw std::out_of_range{"hierarchical_bitset range check failed"};
+    }
+
+    void set(size_type position) noexcept
+    {
+        if (position >= m_bits)
+        {
+            return;
+        }
+        for (size_type level_{0}; level_ < m_levels; ++level_)
+        {
+            auto& word_ref_ = word_(level_, position);
+            const bool was_empty_ = !word_ref_;
+            word_ref_ |= bit_mask_(position);
+            if (!was_empty_)
+            {
+                return;
+            }
+            position /= BITS_IN_WORD;
+        }
+    }
+
+    void reset(size_type position) noexcept
+    {
+        if (position >= m_bits)
+        {
+            return;
+        }
+        for (size_type level_{0}; level_ < m_levels; ++level_)
+        {
+            auto& word_ref_ = word_(level_, position);
+            word_ref_ &= ~bit_mask_(position);
+            if (word_ref_)
+            {
+                return;
+            }
+            position /= BITS_IN_WORD;
+        }
+    }
+
+    /**
+     * @brief Clears all bits
+     */
+    void reset() noexcept
+    {
+        m_words.assign(m_words.size(), 0);
+    }
+
+    inline bool any() const noexcept
+    {
+        return m_words.back() != 0;
+    }
+
+    inline bool none() const noexcept
+    {
+        return !any();
+    }
+
+    /* Search: positions are returned as size_type, size() if not found */
+
+    /**
+     * @brief Position of the first set bit
+     */
+    inline size_type find_first() const noexcept
+    {
+        return find_from_(0);
+    }
+
+    /**
+     * @brief Position of the first set bit after position
+     */
+    inline size_type find_next(size_type position) const noexcept
+    {
+        return position < m_bits ? find_from_(position + 1) : m_bits;
+    }
+
+    /**
+     * @brief Position of the last set bit
+     */
+    size_type find_last() const noexcept
+    {
+        if (none())
+        {
+            return m_bits;
+        }
+        size_type position_{0};
+        for (size_type level_{m_levels}; level_-- > 0;)
+        {
+            position_ = position_ * BITS_IN_WORD + detail::minimal_bitset::highest_bit_(
+                word_(level_, position_ * BITS_IN_WORD));
+        }
+        return position_;
+    }
+};
+
+} // namespace containers
+
+using hierarchical_bitset_t = containers::hierarchical_bitset;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_HIERARCHICAL_BITSET_HPP_ */
@@ -0,0 +1,564 @@
+#ifndef ECSL_CONTAINERS_INPLACE_VECTOR_HPP_
+#define ECSL_CONTAINERS_INPLACE_VECTOR_HPP_
+
+/**
+ * @file InplaceVector.hpp
+ * Declares vector with fixed compile time capacity and no allocation
+ *
+ * The size is stored in the minimal unsigned integer able to hold N,
+ * so inplace_vector<std::uint8_t, 15> takes 16 bytes.
+ * For trivial T (trivially copyable and trivially default constructible)
+ * the elements are a plain array: the vector is trivially copyable and all
+ * the operations are usable in constant expressions (the array is zeroed on
+ * construction, C++17 constexpr constructors must initialize every member).
+ * Other types live in an uninitialized union member and are managed with
+ * placement new, such vectors are not usable in constant expressions (but
+ * still trivially copyable when T is).
+ *
+ * Sources:
+ *  P0843 "inplace_vector"
+ */
+
+/// STD
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+/// ECSL
+#include <ecsl/containers/detail/ValueTrait.hpp>
+#include <ecsl/type_traits/MinimalInteger.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace inplace_vector {
+
+/**
+ * Count of bytes of the minimal integer able to hold value
+ */
+constexpr std::size_t bytes_for(std::size_t value) noexcept
+{
+    return value <= 0xFFu ? 1 : value <= 0xFFFFu ? 2 : value <= 0xFFFFFFFFu ? 4 : 8;
+}
+
+template<class T>
+struct is_trivial : std::integral_constant<bool,
+    std::is_trivially_copyable<T>::value && std::is_trivially_default_constructible<T>::value>
+{};
+
+/**
+ * Storage of trivial elements: plain array, special members are trivial
+ */
+template<class T, std::size_t N, class Size, bool = is_trivial<T>::value,
+    bool = std::is_trivially_copyable<T>::value>
+struct storage
+{
+    T m_data[N];
+    Size m_size;
+
+    constexpr storage() noexcept : m_data{}, m_size{0} {}
+
+    template<class ... Args>
+    constexpr void construct_(std::size_t position, Args&& ... args)
+    {
+        m_data[position] = T(std::forward<Args>(args)...);
+    }
+
+    constexpr void destroy_(std::size_t, std::size_t) noexcept {}
+};
+
+/**
+ * Storage of trivially copyable elements without trivial default
+ * constructor: elements are constructed explicitly, special members are
+ * trivial (copies the whole union)
+ */
+template<class T, std::size_t N, class Size>
+struct storage<T, N, Size, false, true>
+{
+    union
+    {
+        T m_data[N];
+    };
+    Size m_size;
+
+    storage() noexcept : m_size{0} {}
+
+    template<class ... Args>
+    void construct_(std::size_t position, Args&& ... args)
+    {
+        ::new(static_cast<void*>(m_data + position)) T(std::forward<Args>(args)...);
+    }
+
+    void destroy_(std::size_t, std::size_t) noexcept {}
+};
+
+/**
+ * Storage of other elements: lifetime of [0, m_size) is managed explicitly
+ */
+template<class T, std::size_t N, class Size>
+struct storage<T, N, Size, false, false>
+{
+    union
+    {
+        T m_data[N];
+    };
+    Size m_size;
+
+    storage() noexcept : m_size{0} {}
+
+    storage(const storage& other) : m_size{0}
+    {
+        try
+        {
+            for (; m_size < other.m_size; ++m_size)
+            {
+                construct_(m_size, other.m_data[m_size]);
+            }
+        }
+        catch (...)
+        {   //? The destructor does not run for a partly constructed object
+            destroy_(0, m_size);
+            throw;
+        }
+    }
+
+    storage(storage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : m_size{0}
+    {
+        try
+        {
+            for (; m_size < other.m_size; ++m_size)
+            {
+                construct_(m_size, std::move(other.m_data[m_size]));
+            }
+        }
+        catch (...)
+        {
+            destroy_(0, m_size);
+            throw;
+        }
+    }
+
+    storage& operator=(const storage& other)
+    {
+        if (this != &other)
+        {
+            assign_(other.m_data, other.m_size);
+        }
+        return *this;
+    }
+
+    storage& operator=(storage&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value)
+    {
+        if (this != &other)
+        {
+            assign_(std::make_move_iterator(other.m_data), other.m_size);
+        }
+        return *this;
+    }
+
+    ~storage()
+    {
+        destroy_(0, m_size);
+    }
+
+    template<class ... Args>
+    void construct_(std::size_t position, Args&& ... args)
+    {
+        ::new(static_cast<void*>(m_data + position)) T(std::forward<Args>(args)...);
+    }
+
+    void destroy_(std::size_t first, std::size_t last) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<T>::value)
+        {
+            for (; first < last; ++first)
+            {
+                m_data[first].~T();
+            }
+        }
+    }
+
+    /**
+     * Assigns over common elements, constructs or destroys the rest
+     */
+    template<class It>
+    void assign_(It src, Size count)
+    {
+        const Size common_ = count < m_size ? count : m_size;
+        for (Size i{0}; i < common_; ++i, ++src)
+        {
+            m_data[i] = *src;
+        }
+        destroy_(count, m_size);
+        m_size = common_;
+        for (; m_size < count; ++m_size, ++src)
+        {
+            construct_(m_size, *src);
+        }
+    }
+};
+
+} // namespace inplace_vector
+} // namespace detail
+
+/**
+ * @brief Contiguous sequence container of at most N elements stored inline
+ * Operations that exceed the capacity throw std::length_error, try_ and
+ * unchecked_ variants do not.
+ */
+template<class T, std::size_t N>
+class inplace_vector : private detail::inplace_vector::storage<T, N,
+    unsigned_minimal_integer_t<types::memory_t[detail::inplace_vector::bytes_for(N)]>>
+{
+    static_assert(N > 0, "inplace_vector requires capacity N > 0");
+
+    using vt_t = detail::value_trait<T>;
+    using base_t = detail::inplace_vector::storage<T, N,
+        unsigned_minimal_integer_t<types::memory_t[detail::inplace_vector::bytes_for(N)]>>;
+
+    using base_t::m_data;
+    using base_t::m_size;
+    using base_t::construct_;
+    using base_t::destroy_;
+
+  public:
+    using value_type                = typename vt_t::value_type;
+    using reference                 = typename vt_t::reference;
+    using const_reference           = typename vt_t::const_reference;
+    using pointer                   = typename vt_t::pointer;
+    using const_pointer             = typename vt_t::const_pointer;
+    /**
+     * Minimal unsigned integer able to hold N
+     */
+    using size_type                 = unsigned_minimal_integer_t<
+        types::memory_t[detail::inplace_vector::bytes_for(N)]>;
+    using difference_type           = std::ptrdiff_t;
+    using iterator                  = pointer;
+    using const_iterator            = const_pointer;
+    using reverse_iterator          = std::reverse_iterator<iterator>;
+    using const_reverse_iterator    = std::reverse_iterator<const_iterator>;
+
+  private:
+    static constexpr void check_capacity_(std::size_t count)
+    {
+        if (count > N)
+        {
+            throw std::length_error{"inplace_vector length error"};
+        }
+    }
+
+  public:
+    constexpr inplace_vector() noexcept = default;
+
+    constexpr explicit inplace_vector(std::size_t count) : inplace_vector()
+    {
+        resize(count);
+    }
+
+    constexpr inplace_vector(std::size_t count, const value_type& value) : inplace_vector()
+    {
+        resize(count, value);
+    }
+
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    constexpr inplace_vector(InputIt first, InputIt last) : inplace_vector()
+    {
+        assign(first, last);
+    }
+
+    constexpr inplace_vector(std::initializer_list<value_type> init) : inplace_vector()
+    {
+        assign(init.begin(), init.end());
+    }
+
+    constexpr inplace_vector& operator=(std::initializer_list<value_type> init)
+    {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    constexpr void assign(InputIt first, InputIt last)
+    {
+        clear();
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    constexpr void assign(std::size_t count, const value_type& value)
+    {
+        clear();
+        resize(count, value);
+    }
+
+    /* Capacity */
+
+    constexpr size_type size() const noexcept { return m_size; }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+    static constexpr size_type capacity() noexcept { return N; }
+    static constexpr size_type max_size() noexcept { return N; }
+    constexpr bool full() const noexcept { return m_size == N; }
+
+    /* Element access */
+
+    constexpr pointer data() noexcept { return m_data; }
+    constexpr const_pointer data() const noexcept { return m_data; }
+
+    constexpr reference operator[](std::size_t position) noexcept { return m_data[position]; }
+    constexpr const_reference operator[](std::size_t position) const noexcept { return m_data[position]; }
+
+    constexpr reference at(std::size_t position)
+    {
+        if (position < m_size)
+        {
+            return m_data[position];
+        }
+        throw std::out_of_range{"inplace_vector range check failed"};
+    }
+
+    constexpr const_reference at(std::size_t position) const
+    {
+        if (position < m_size)
+        {
+            return m_data[position];
+        }
+        throw std::out_of_range{"inplace_vector range check failed"};
+    }
+
+    constexpr reference front() noexcept { return m_data[0]; }
+    constexpr const_reference front() const noexcept { return m_data[0]; }
+    constexpr reference back() noexcept { return m_data[m_size - 1]; }
+    constexpr const_reference back() const noexcept { return m_data[m_size - 1]; }
+
+    /* Iterators */
+
+    constexpr iterator begin() noexcept { return m_data; }
+    constexpr const_iterator begin() const noexcept { return m_data; }
+    constexpr const_iterator cbegin() const noexcept { return m_data; }
+    constexpr iterator end() noexcept { return m_data + m_size; }
+    constexpr const_iterator end() const noexcept { return m_data + m_size; }
+    constexpr const_iterator cend() const noexcept { return m_data + m_size; }
+
+    constexpr reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+    constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{end()}; }
+    constexpr reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+    constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator{begin()}; }
+
+    /* Modifiers */
+
+    /**
+     * @brief Appends an element, the vector must not be full
+     */
+    template<class ... Args>
+    constexpr reference unchecked_emplace_back(Args&& ... args)
+    {
+        construct_(m_size, std::forward<Args>(args)...);
+        return m_data[m_size++];
+    }
+
+    template<class ... Args>
+    constexpr reference emplace_back(Args&& ... args)
+    {
+        check_capacity_(m_size + std::size_t{1});
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Appends an element if the vector is not full
+     * @return Pointer to the element or nullptr
+     */
+    template<class ... Args>
+    constexpr pointer try_emplace_back(Args&& ... args)
+    {
+        return m_size < N ? &unchecked_emplace_back(std::forward<Args>(args)...) : nullptr;
+    }
+
+    constexpr void push_back(const value_type& value) { emplace_back(value); }
+    constexpr void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+    constexpr pointer try_push_back(const value_type& value) { return try_emplace_back(value); }
+    constexpr pointer try_push_back(value_type&& value) { return try_emplace_back(std::move(value)); }
+
+    constexpr void pop_back() noexcept
+    {
+        --m_size;
+        destroy_(m_size, m_size + std::size_t{1});
+    }
+
+    template<class ... Args>
+    constexpr iterator emplace(const_iterator position, Args&& ... args)
+    {
+        const auto index_ = position - begin();
+        emplace_back(std::forward<Args>(args)...);
+        rotate_(begin() + index_, end() - 1, end());
+        return begin() + index_;
+    }
+
+    constexpr iterator insert(const_iterator position, const value_type& value)
+    {
+        return emplace(position, value);
+    }
+
+    constexpr iterator insert(const_iterator position, value_type&& value)
+    {
+        return emplace(position, std::move(value));
+    }
+
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    constexpr iterator insert(const_iterator position, InputIt first, InputIt last)
+    {
+        const auto index_ = position - begin();
+        const auto size_ = m_size;
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+        rotate_(begin() + index_, begin() + size_, end());
+        return begin() + index_;
+    }
+
+    constexpr iterator insert(const_iterator position, std::initializer_list<value_type> init)
+    {
+        return insert(position, init.begin(), init.end());
+    }
+
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        const auto index_ = first - begin();
+        const auto count_ = last - first;
+        if (count_)
+        {
+            for (auto i = index_; i + count_ < m_size; ++i)
+            {
+                m_data[i] = std::move(m_data[i + count_]);
+            }
+            destroy_(m_size - count_, m_size);
+            m_size = static_cast<size_type>(m_size - count_);
+        }
+        return begin() + index_;
+    }
+
+    constexpr iterator erase(const_iterator position)
+    {
+        return erase(position, position + 1);
+    }
+
+    constexpr void resize(std::size_t count)
+    {
+        check_capacity_(count);
+        if (count < m_size)
+        {
+            destroy_(count, m_size);
+            m_size = static_cast<size_type>(count);
+        }
+        while (m_size < count)
+        {
+            unchecked_emplace_back();
+        }
+    }
+
+    constexpr void resize(std::size_t count, const value_type& value)
+    {
+        check_capacity_(count);
+        if (count < m_size)
+        {
+            destroy_(count, m_size);
+            m_size = static_cast<size_type>(count);
+        }
+        while (m_size < count)
+        {
+            unchecked_emplace_back(value);
+        }
+    }
+
+    constexpr void clear() noexcept
+    {
+        destroy_(0, m_size);
+        m_size = 0;
+    }
+
+    constexpr void swap(inplace_vector& other)
+    {
+        inplace_vector tmp_{std::move(other)};
+        other = std::move(*this);
+        *this = std::move(tmp_);
+    }
+
+    friend constexpr void swap(inplace_vector& lhs, inplace_vector& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    friend constexpr bool operator==(const inplace_vector& lhs, const inplace_vector& rhs)
+    {
+        if (lhs.m_size != rhs.m_size)
+        {
+            return false;
+        }
+        for (size_type i{0}; i < lhs.m_size; ++i)
+        {
+            if (!(lhs.m_data[i] == rhs.m_data[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(const inplace_vector& lhs, const inplace_vector& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const inplace_vector& lhs, const inplace_vector& rhs)
+    {
+        for (size_type i{0}; i < lhs.m_size && i < rhs.m_size; ++i)
+        {
+            if (lhs.m_data[i] < rhs.m_data[i])
+            {
+                return true;
+            }
+            if (rhs.m_data[i] < lhs.m_data[i])
+            {
+                return false;
+            }
+        }
+        return lhs.m_size < rhs.m_size;
+    }
+
+  private:
+    /**
+     * std::rotate is not constexpr before C++20: reverse based rotation
+     */
+    static constexpr void reverse_(pointer first, pointer last)
+    {
+        for (; first != last && first != --last; ++first)
+        {
+            auto tmp_ = std::move(*first);
+            *first = std::move(*last);
+            *last = std::move(tmp_);
+        }
+    }
+
+    static constexpr void rotate_(pointer first, pointer middle, pointer last)
+    {
+        reverse_(first, middle);
+        reverse_(middle, last);
+        reverse_(first, last);
+    }
+};
+
+} // namespace containers
+
+template<class T, std::size_t N>
+using inplace_vector_t = containers::inplace_vector<T, N>;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_INPLACE_VECTOR_HPP_ */
@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <type_traits>
 /// ECSL
+#include <ecsl/platform/Compiler.hpp>
+#include <ecsl/type_traits/MinimalInteger.hpp>
 #include <ecsl/type_traits/SimpleTypes.hpp>
 
 namespace ecsl {
@@ -16,94 +18,88 @@ namespace minimal_bitset {
 
 /**
  * Reference-like object for a single bit
+ * @tparam Word Storage word type (const-qualified for read-only reference)
  */
+template<class Word>
 struct bit_reference
 {
-    types::memory_t* m_byte;
+    using word_type = typename std::remove_const<Word>::type;
+
+    Word* m_word;
     types::length_t m_bit;
 
-    inline bit_reference& operator=(bool value) noexcept
+    constexpr bit_reference& operator=(bool value) noexcept
     {
+        const auto mask_ = static_cast<word_type>(word_type{1} << m_bit);
         if (value)
         {
-            *m_byte |= (1 << m_bit);
+            *m_word = static_cast<word_type>(*m_word | mask_);
         }
         else
         {
-            *m_byte = *m_byte ^ (*m_byte | (1 << m_bit));
+            *m_word = static_cast<word_type>(*m_word & ~mask_);
         }
         return *this;
     }
 
-    inline bit_reference& operator=(const bit_reference& other) noexcept
+    constexpr bit_reference& operator=(const bit_reference& other) noexcept
     {
         auto value_ = static_cast<bool>(other);
         return *this = value_;
     }
 
-    inline bit_reference& flip() noexcept
+    constexpr bit_reference& flip() noexcept
     {
         return *this = !(*this);
     }
 
-    inline bool test() const noexcept
+    constexpr bool test() const noexcept
     {
         return static_cast<bool>(*this);
     }
 
-    inline bool operator!() const noexcept
+    constexpr bool operator!() const noexcept
     {
         return !static_cast<bool>(*this);
     }
 
-    inline operator bool() const noexcept
+    constexpr operator bool() const noexcept
     {
-        return *m_byte & (1 << m_bit);
+        return (*m_word >> m_bit) & 1;
     }
 };
 
 /**
  * Pointer-like object for a single bit
+ * @tparam Word Storage word type (const-qualified for read-only pointer)
  */
+template<class Word>
 struct bit_pointer
 {
-    types::memory_t* m_byte;
+    static constexpr std::size_t BITS_IN_WORD = sizeof(Word) * CHAR_BIT;
+
+    Word* m_word;
     types::length_t m_bit;
 
-    inline bit_reference operator*() noexcept { return {m_byte, m_bit}; }
-    inline const bit_reference operator*() const noexcept { return {m_byte, m_bit}; }
+    constexpr bit_reference<Word> operator*() const noexcept { return {m_word, m_bit}; }
 
-    inline bit_reference flip() noexcept
+    constexpr bit_reference<Word> flip() noexcept
     {
         (**this).flip();
-        return {m_byte, m_bit};
+        return {m_word, m_bit};
     }
 
-    inline bool test() const noexcept
+    constexpr bool test() const noexcept
     {
         return (**this).test();
     }
 
-    inline bit_pointer& operator->() noexcept { return *this; }
-    inline const bit_pointer& operator->() const noexcept { return *this; }
-
-    inline bit_reference operator[](std::size_t pos) noexcept
+    constexpr bit_reference<Word> operator[](std::size_t pos) const noexcept
     {
-        return {m_byte + pos / CHAR_BIT, m_bit + pos % CHAR_BIT};
-    }
-    inline const bit_reference operator[](std::size_t pos) const noexcept
-    {
-        return {m_byte + pos / CHAR_BIT, m_bit + pos % CHAR_BIT};
+        return {m_word + (m_bit + pos) / BITS_IN_WORD, (m_bit + pos) % BITS_IN_WORD};
     }
 };
 
-constexpr std::size_t swar_1_(unsigned char i) noexcept
-{
-    i = i - ((i >> 1) & 0x55);
-    i = (i & 0x33) + ((i >> 2) & 0x33);
-    return ((i >> 4) + i) & 0x0F;
-}
-
 constexpr std::size_t swar_8_(unsigned long long i) noexcept
 {
     i = i - (i >> 1 & 0x5555555555555555ULL);
@@ -111,84 +107,123 @@ constexpr std::size_t swar_8_(unsigned long long i) noexcept
     return ((((i >> 4) + i) & 0x0F0F0F0F0F0F0F0FULL) * 0x0101010101010101ULL) >> (64-8);
 }
 
-using ull_t = unsigned long long;
+/**
+ * Population count of a word: popcnt builtin (usable in constant
+ * expressions for gcc/clang) or portable SWAR
+ */
+template<class Word>
+constexpr std::size_t popcount_(Word i) noexcept
+{
+    static_assert(sizeof(Word) <= sizeof(unsigned long long), "");
+#if defined(ECSL_COMPILER_GCC) || defined(ECSL_COMPILER_CLANG)
+    return static_cast<std::size_t>(__builtin_popcountll(i));
+#else
+    return swar_8_(i);
+#endif
+}
 
-constexpr ull_t pack_(types::memory_t* data, std::size_t count = 8) noexcept
+/**
+ * Index of the lowest set bit of non-zero word
+ */
+template<class Word>
+constexpr std::size_t lowest_bit_(Word i) noexcept
 {
-    static_assert(sizeof(ull_t) == 8, "");
-    ull_t i_{0};
-    switch (count)
-    {
-        default:
-        case 8: i_ |= static_cast<ull_t>(data[7]) << (8 * 7);
-        case 7: i_ |= static_cast<ull_t>(data[6]) << (8 * 6);
-        case 6: i_ |= static_cast<ull_t>(data[5]) << (8 * 5);
-        case 5: i_ |= static_cast<ull_t>(data[4]) << (8 * 4);
-        case 4: i_ |= static_cast<ull_t>(data[3]) << (8 * 3);
-        case 3: i_ |= static_cast<ull_t>(data[2]) << (8 * 2);
-        case 2: i_ |= static_cast<ull_t>(data[1]) << (8 * 1);
-        case 1: i_ |= static_cast<ull_t>(data[0]) << (8 * 0);
-        case 0: break;
-    }
-    return i_;
+#if defined(ECSL_COMPILER_GCC) || defined(ECSL_COMPILER_CLANG)
+    return static_cast<std::size_t>(__builtin_ctzll(i));
+#else
+    std::size_t r_{0};
+    while (!((i >> r_) & 1))
+    {
+        ++r_;
+    }
+    return r_;
+#endif
 }
 
-constexpr void unpack_(ull_t i, types::memory_t* data) noexcept
+/**
+ * Index of the highest set bit of non-zero word
+ */
+template<class Word>
+constexpr std::size_t highest_bit_(Word i) noexcept
 {
-    data[0] = (i >> (8 * 0)) & 0xFF;
-    data[1] = (i >> (8 * 1)) & 0xFF;
-    data[2] = (i >> (8 * 2)) & 0xFF;
-    data[3] = (i >> (8 * 3)) & 0xFF;
-    data[4] = (i >> (8 * 4)) & 0xFF;
-    data[5] = (i >> (8 * 5)) & 0xFF;
-    data[6] = (i >> (8 * 6)) & 0xFF;
-    data[7] = (i >> (8 * 7)) & 0xFF;
+#if defined(ECSL_COMPILER_GCC) || defined(ECSL_COMPILER_CLANG)
+    return static_cast<std::size_t>(63 - __builtin_clzll(i));
+#else
+    std::size_t r_{sizeof(Word) * CHAR_BIT - 1};
+    while (!((i >> r_) & 1))
+    {
+        --r_;
+    }
+    return r_;
+#endif
 }
 
+/**
+ * Storage word: minimal unsigned integer for up to 64 bits,
+ * unsigned long long for longer sets
+ */
+template<std::size_t BITS_COUNT>
+using default_word_t = unsigned_minimal_integer_t<types::memory_t[
+    (BITS_COUNT + CHAR_BIT - 1) / CHAR_BIT < sizeof(unsigned long long) ?
+        (BITS_COUNT + CHAR_BIT - 1) / CHAR_BIT : sizeof(unsigned long long)
+]>;
+
 } // namespace minimal_bitset
 } // namespace detail
 
 /**
  * @brief Constant length bit vector
- * Has a minimal possible storage size for BITS_COUNT bits
- * Intended to be operatable in constexpr context
- * (operations are not platform/instruction set optimized).
+ * Has a minimal possible storage size (rounded up to whole words)
+ * for BITS_COUNT bits.
+ * Operatable in constexpr context; at run time word-wide operations and
+ * popcnt are used (with types::memory_t word the layout is byte-minimal).
  * Like std::bitset but with iterators and more of std::array symantics.
  * @tparam BITS_COUNT Bit length of vector
+ * @tparam Word Unsigned integer storage word
  */
-template<std::size_t BITS_COUNT>
+template<std::size_t BITS_COUNT,
+    class Word = detail::minimal_bitset::default_word_t<BITS_COUNT>>
 class minimal_bitset
 {
+    template<std::size_t, class>
+    friend class minimal_bitset;
+
+    static_assert(std::is_unsigned<Word>::value, "Word must be an unsigned integer");
+
     static constexpr std::size_t BITS_IN_BYTE =
         CHAR_BIT;
+    static constexpr std::size_t BITS_IN_WORD =
+        sizeof(Word) * CHAR_BIT;
     static constexpr std::size_t LAST_BIT =
-        (BITS_COUNT - 1) % CHAR_BIT;
+        (BITS_COUNT - 1) % BITS_IN_WORD;
     static constexpr std::size_t CAPACITY =
-        (BITS_COUNT + (BITS_IN_BYTE - 1)) / BITS_IN_BYTE;
-    static constexpr auto BYTE_MASK =
-        static_cast<types::memory_t>(~0);
+        (BITS_COUNT + (BITS_IN_WORD - 1)) / BITS_IN_WORD;
+    static constexpr auto WORD_MASK =
+        static_cast<Word>(~Word{0});
     static constexpr auto LAST_MASK =
-        static_cast<types::memory_t>((1 << (LAST_BIT + 1)) - 1);
+        static_cast<Word>(WORD_MASK >> (BITS_IN_WORD - 1 - LAST_BIT));
 
-    static_assert(CAPACITY != 0, "Can't create minimal_bitset of zero length");
+    static_assert(BITS_COUNT != 0, "Can't create minimal_bitset of zero length");
 
-    types::memory_t m_bytes[CAPACITY];
+    //? Bits past BITS_COUNT in the last word are always zero
+    Word m_words[CAPACITY];
 
     template<bool IS_CONST>
     class iterator_impl
     {
         friend class minimal_bitset;
-        using Container = minimal_bitset;
+        using Container = typename std::conditional<IS_CONST,
+            const minimal_bitset,
+            minimal_bitset
+        >::type;
+        using word_type = typename std::conditional<IS_CONST,
+            const Word,
+            Word
+        >::type;
 
       public:
-        using value_type        = typename std::conditional<IS_CONST,
-            const detail::minimal_bitset::bit_reference,
-            detail::minimal_bitset::bit_reference
-        >::type;
-        using pointer           = typename std::conditional<IS_CONST,
-            const detail::minimal_bitset::bit_pointer,
-            detail::minimal_bitset::bit_pointer
-        >::type
+        using value_type        = detail::minimal_bitset::bit_reference<word_type>;
+        using pointer           = detail::minimal_bitset::bit_pointer<word_type>;
         using reference         = value_type;
         using iterator_category = std::random_access_iterator_tag;
         using difference_type   = std::ptrdiff_t;
@@ -200,7 +235,10 @@ class minimal_bitset
 
         constexpr pointer get_pointer() const noexcept
         {
-            return {m_container->m_bytes + m_bit / BITS_IN_BYTE, m_bit % BITS_IN_BYTE};
+            return {
+                m_container->m_words + m_bit / BITS_IN_WORD,
+                static_cast<types::length_t>(m_bit % BITS_IN_WORD)
+            };
         }
 
       public:
@@ -318,7 +356,86 @@ class minimal_bitset
         difference_type m_bit;
     };
 
+    /**
+     * Forward iterator over positions of set (or zero) bits
+     */
+    template<bool ZERO>
+    class index_iterator
+    {
+        friend class minimal_bitset;
+
+      public:
+        using value_type        = std::size_t;
+        using pointer           = const value_type*;
+        using reference         = value_type;
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+
+      private:
+        constexpr index_iterator(const minimal_bitset* container, value_type bit) noexcept :
+            m_container{container}, m_bit{bit}
+        {}
+
+      public:
+        constexpr index_iterator() noexcept : m_container{nullptr}, m_bit{0} {}
+
+        constexpr reference operator*() const noexcept { return m_bit; }
+
+        constexpr index_iterator& operator++() noexcept
+        {
+            m_bit = m_container->template find_from_<ZERO>(m_bit + 1);
+            return *this;
+        }
+        constexpr index_iterator operator++(int) noexcept
+        {
+            index_iterator old{*this};
+            ++(*this);
+            return old;
+        }
+
+        friend constexpr bool
+            operator==(const index_iterator& lhs, const index_iterator& rhs) noexcept
+        {   //? This operation must not be defined for different containers
+            return lhs.m_bit == rhs.m_bit;
+        }
+        friend constexpr bool
+            operator!=(const index_iterator& lhs, const index_iterator& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+      private:
+        const minimal_bitset* m_container;
+        value_type m_bit;
+    };
+
+    template<bool ZERO>
+    class index_range
+    {
+        friend class minimal_bitset;
+
+        constexpr explicit index_range(const minimal_bitset* container) noexcept :
+            m_container{container}
+        {}
+
+      public:
+        using iterator = index_iterator<ZERO>;
+
+        constexpr iterator begin() const noexcept
+        {
+            return {m_container, m_container->template find_from_<ZERO>(0)};
+        }
+        constexpr iterator end() const noexcept
+        {
+            return {m_container, BITS_COUNT};
+        }
+
+      private:
+        const minimal_bitset* m_container;
+    };
+
   public:
+    using word_type         = Word;
     using iterator          = iterator_impl<false>;
     using const_iterator    = iterator_impl<true>;
     using pointer           = typename iterator::pointer;
@@ -328,152 +445,158 @@ class minimal_bitset
     using size_type         = std::size_t;
     using ssize_type        = typename std::make_signed<size_type>::type;
 
-    template<size_type N>
-    constexpr minimal_bitset& operator=(const char(&val)[N]) noexcept
+  private:
+    /**
+     * Assigns bytes (little-endian bit order: bit i is bit i % 8 of byte i / 8)
+     */
+    template<class Byte, size_type N>
+    constexpr void assign_bytes_(const Byte(&val)[N]) noexcept
     {
-        for (size_type i{0}; i + 1 < CAPACITY; ++i)
+        for (size_type i{0}; i < CAPACITY; ++i)
+        {
+            m_words[i] = 0;
+        }
+        for (size_type i{0}; i < N && i * BITS_IN_BYTE < BITS_COUNT; ++i)
         {
-            m_bytes[i] = i < N ? val[i] : 0;
+            const auto byte_ = static_cast<Word>(static_cast<types::memory_t>(val[i]));
+            m_words[i * BITS_IN_BYTE / BITS_IN_WORD] = static_cast<Word>(
+                m_words[i * BITS_IN_BYTE / BITS_IN_WORD] |
+                (byte_ << (i * BITS_IN_BYTE % BITS_IN_WORD))
+            );
         }
-        m_bytes[CAPACITY-1] =
-            ((CAPACITY-1 <= N ? val[CAPACITY-1] : 0) & LAST_MASK) |
-            (m_bytes[CAPACITY-1] & ~LAST_MASK);
+        m_words[CAPACITY-1] &= LAST_MASK;
+    }
+
+  public:
+    template<size_type N>
+    constexpr minimal_bitset& operator=(const char(&val)[N]) noexcept
+    {
+        assign_bytes_(val);
         return *this;
     }
 
     template<size_type N>
     constexpr minimal_bitset& operator=(const types::memory_t(&val)[N]) noexcept
     {
-        for (size_type i{0}; i + 1 < CAPACITY; ++i)
-        {
-            m_bytes[i] = i < N ? val[i] : 0;
-        }
-        m_bytes[CAPACITY-1] =
-            ((CAPACITY-1 <= N ? val[CAPACITY-1] : 0) & LAST_MASK) |
-            (m_bytes[CAPACITY-1] & ~LAST_MASK);
+        assign_bytes_(val);
         return *this;
     }
 
   private:
     static constexpr bool check_position_(
         size_type pos,
-        size_type& byte,
+        size_type& word,
         size_type& bit
     ) noexcept
     {
-        byte = pos / BITS_IN_BYTE;
-        bit = pos % BITS_IN_BYTE;
-        return !((byte >= CAPACITY) || (byte == CAPACITY-1 && bit > LAST_BIT));
+        word = pos / BITS_IN_WORD;
+        bit = pos % BITS_IN_WORD;
+        return pos < BITS_COUNT;
+    }
+
+    static constexpr Word bit_mask_(size_type bit) noexcept
+    {
+        return static_cast<Word>(Word{1} << bit);
     }
 
   public:
     constexpr void set(size_type position) noexcept
     {
-        const size_type byte_{}, bit_{};
-        if (!check_position_(position, byte_, bit_))
+        size_type word_{}, bit_{};
+        if (!check_position_(position, word_, bit_))
         {
             return;
         }
-        m_bytes[byte_] |= (1 << bit_);
+        m_words[word_] |= bit_mask_(bit_);
     }
 
     constexpr void set() noexcept
     {
         for (size_type i{0}; i + 1 < CAPACITY; ++i)
         {
-            m_bytes[i] = BYTE_MASK;
+            m_words[i] = WORD_MASK;
         }
-        m_bytes[CAPACITY-1] = LAST_MASK;
+        m_words[CAPACITY-1] = LAST_MASK;
     }
 
     constexpr void reset(size_type position) noexcept
     {
-        const size_type byte_{}, bit_{};
-        if (!check_position_(position, byte_, bit_))
+        size_type word_{}, bit_{};
+        if (!check_position_(position, word_, bit_))
         {
             return;
         }
-        m_bytes[byte_] =
-            m_bytes[byte_] ^ (m_bytes[byte_] | (1 << bit_));
+        m_words[word_] &= static_cast<Word>(~bit_mask_(bit_));
     }
 
     constexpr void reset() noexcept
     {
-        for (size_type i{0}; i + 1 < CAPACITY; ++i)
+        for (size_type i{0}; i < CAPACITY; ++i)
         {
-            m_bytes[i] = 0;
+            m_words[i] = 0;
         }
-        m_bytes[CAPACITY-1] &= ~LAST_MASK;
     }
 
     constexpr void flip(size_type position) noexcept
     {
-        const size_type byte_{}, bit_{};
-        if (!check_position_(position, byte_, bit_))
+        size_type word_{}, bit_{};
+        if (!check_position_(position, word_, bit_))
         {
             return;
         }
-        m_bytes[byte_] ^= (1 << bit_);
+        m_words[word_] ^= bit_mask_(bit_);
     }
 
     constexpr void flip() noexcept
     {
         for (size_type i{0}; i + 1 < CAPACITY; ++i)
         {
-            m_bytes[i] ^= BYTE_MASK;
+            m_words[i] ^= WORD_MASK;
         }
-        m_bytes[CAPACITY-1] ^= LAST_MASK;
+        m_words[CAPACITY-1] ^= LAST_MASK;
     }
 
     constexpr bool test(size_type position) const noexcept
     {
-        const size_type byte_{}, bit_{};
-        if (!check_position_(position, byte_, bit_))
+        size_type word_{}, bit_{};
+        if (!check_position_(position, word_, bit_))
         {
             return false;
         }
-        return m_bytes[byte_] & (1 << bit_);
+        return (m_words[word_] >> bit_) & 1;
     }
 
     constexpr bool any() const noexcept
     {
-        for (size_type i{0}; i + 1 < CAPACITY; ++i)
+        for (size_type i{0}; i < CAPACITY; ++i)
         {
-            if (m_bytes[i])
+            if (m_words[i])
             {
                 return true;
             }
         }
-        return m_bytes[CAPACITY-1] & LAST_MASK;
+        return false;
     }
 
     constexpr bool all() const noexcept
     {
         for (size_type i{0}; i + 1 < CAPACITY; ++i)
         {
-            if (m_bytes[i] != BYTE_MASK)
+            if (m_words[i] != WORD_MASK)
             {
                 return false;
             }
         }
-        return m_bytes[CAPACITY-1] == LAST_MASK;
+        return m_words[CAPACITY-1] == LAST_MASK;
     }
 
     constexpr size_type count() const noexcept
     {
-        using namespace detail::minimal_bitset;
-        //? Count of full bytes
-        constexpr auto LENGTH_ = CAPACITY-1;
-        constexpr auto ROUNDS_ = LENGTH_ / 8;
-        constexpr auto OFFSET_ = LENGTH_ % 8;
-        //? Count bits in last byte
-        size_type r_ = swar_1_(m_bytes[LENGTH_] & LAST_MASK);
-        auto round_ = ROUNDS_;
-        while (round_-- > 0)
+        size_type r_{0};
+        for (size_type i{0}; i < CAPACITY; ++i)
         {
-            r_ += swar_8_(pack_(m_bytes + 8 * round_ + OFFSET_));
+            r_ += detail::minimal_bitset::popcount_(m_words[i]);
         }
-        r_ += swar_8_(pack_(m_bytes, OFFSET_));
         return r_;
     }
 
@@ -482,6 +605,134 @@ class minimal_bitset
         return BITS_COUNT;
     }
 
+    /**
+     * @brief Count of words holding size() bits
+     */
+    static constexpr size_type word_count() noexcept
+    {
+        return CAPACITY;
+    }
+
+    //? Bits past size() in the last word are always zero
+    constexpr const word_type* data() const noexcept { return m_words; }
+
+  private:
+    template<bool ZERO>
+    constexpr Word load_(size_type word) const noexcept
+    {
+        if (ZERO)
+        {
+            return static_cast<Word>(~m_words[word] &
+                (word + 1 == CAPACITY ? LAST_MASK : WORD_MASK));
+        }
+        return m_words[word];
+    }
+
+    /**
+     * Position of the first set (zero) bit at or after pos or BITS_COUNT
+     */
+    template<bool ZERO>
+    constexpr size_type find_from_(size_type pos) const noexcept
+    {
+        if (pos >= BITS_COUNT)
+        {
+            return BITS_COUNT;
+        }
+        size_type word_ = pos / BITS_IN_WORD;
+        auto bits_ = static_cast<Word>(
+            load_<ZERO>(word_) & (WORD_MASK << (pos % BITS_IN_WORD)));
+        while (!bits_)
+        {
+            if (++word_ == CAPACITY)
+            {
+                return BITS_COUNT;
+            }
+            bits_ = load_<ZERO>(word_);
+        }
+        return word_ * BITS_IN_WORD + detail::minimal_bitset::lowest_bit_(bits_);
+    }
+
+    template<bool ZERO>
+    constexpr size_type find_last_() const noexcept
+    {
+        for (size_type i{CAPACITY}; i-- > 0;)
+        {
+            if (const auto bits_ = load_<ZERO>(i))
+            {
+                return i * BITS_IN_WORD + detail::minimal_bitset::highest_bit_(bits_);
+            }
+        }
+        return BITS_COUNT;
+    }
+
+  public:
+    /* Search: positions are returned as size_type, size() if not found */
+
+    /**
+     * @brief Position of the first set bit
+     */
+    constexpr size_type find_first() const noexcept
+    {
+        return find_from_<false>(0);
+    }
+
+    /**
+     * @brief Position of the first set bit after position
+     */
+    constexpr size_type find_next(size_type position) const noexcept
+    {
+        return position < BITS_COUNT ? find_from_<false>(position + 1) : BITS_COUNT;
+    }
+
+    /**
+     * @brief Position of the last set bit
+     */
+    constexpr size_type find_last() const noexcept
+    {
+        return find_last_<false>();
+    }
+
+    /**
+     * @brief Position of the first zero bit
+     */
+    constexpr size_type find_first_zero() const noexcept
+    {
+        return find_from_<true>(0);
+    }
+
+    /**
+     * @brief Position of the first zero bit after position
+     */
+    constexpr size_type find_next_zero(size_type position) const noexcept
+    {
+        return position < BITS_COUNT ? find_from_<true>(position + 1) : BITS_COUNT;
+    }
+
+    /**
+     * @brief Position of the last zero bit
+     */
+    constexpr size_type find_last_zero() const noexcept
+    {
+        return find_last_<true>();
+    }
+
+    /**
+     * @brief Range of set bit positions in ascending order
+     * Iteration costs O(count() + size() / word bits)
+     */
+    constexpr index_range<false> set_bits() const noexcept
+    {
+        return index_range<false>{this};
+    }
+
+    /**
+     * @brief Range of zero bit positions in ascending order
+     */
+    constexpr index_range<true> zero_bits() const noexcept
+    {
+        return index_range<true>{this};
+    }
+
     constexpr iterator begin() noexcept { return iterator(this, 0); }
     constexpr const_iterator begin() const noexcept { return const_iterator(this, 0); }
     constexpr const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
@@ -501,15 +752,15 @@ class minimal_bitset
 
     constexpr reference at(size_type position)
     {
-        if (position < CAPACITY)
+        if (position < BITS_COUNT)
         {
             return operator[](position);
         }
         throw std::out_of_range{"minimal_bitset range check failed"};
     }
-    constexpr reference at(size_type position) const
+    constexpr const_reference at(size_type position) const
     {
-        if (position < CAPACITY)
+        if (position < BITS_COUNT)
         {
             return operator[](position);
         }
@@ -524,45 +775,24 @@ class minimal_bitset
 
   private:
     template<std::size_t N, class F>
-    constexpr void swipe_(const minimal_bitset<N>& other, F&& func) noexcept
+    constexpr void swipe_(const minimal_bitset<N, Word>& other, F&& func) noexcept
     {
-        for (size_type i{0}; i + 1 < CAPACITY; ++i)
-        {
-            m_bytes[i] = i + 1 < minimal_bitset<N>::CAPACITY ?
-                func(m_bytes[i], other.m_bytes[i]) :
-                i < minimal_bitset<N>::CAPACITY ?
-                    func(m_bytes[i], other.m_bytes[i] & minimal_bitset<N>::LAST_MASK) :
-                    func(m_bytes[i], 0);
-        }
-        if (CAPACITY <= minimal_bitset<N>::CAPACITY)
-        {
-            m_bytes[CAPACITY-1] =
-                (func(
-                    m_bytes[CAPACITY-1],
-                    other.m_bytes[CAPACITY-1] & (
-                        CAPACITY == minimal_bitset<N>::CAPACITY ?
-                            minimal_bitset<N>::LAST_MASK :
-                            BYTE_MASK
-                    )
-                ) & LAST_MASK) |
-                (m_bytes[CAPACITY-1] & ~LAST_MASK);
-        }
-        else
+        //? Padding bits of other are zero, so no masking of its last word
+        for (size_type i{0}; i < CAPACITY; ++i)
         {
-            m_bytes[CAPACITY-1] =
-                (func(m_bytes[CAPACITY-1], 0) & LAST_MASK) |
-                (m_bytes[CAPACITY-1] & ~LAST_MASK);
+            m_words[i] = func(m_words[i],
+                i < minimal_bitset<N, Word>::CAPACITY ? other.m_words[i] : Word{0});
         }
+        m_words[CAPACITY-1] &= LAST_MASK;
     }
 
   public:
-    template<std::size_t N, class = std::enable_if<N != BITS_COUNT>::type>
-    constexpr minimal_bitset& operator=(const minimal_bitset<N>& other) noexcept
+    template<std::size_t N, class = typename std::enable_if<N != BITS_COUNT>::type>
+    constexpr minimal_bitset& operator=(const minimal_bitset<N, Word>& other) noexcept
     {
         struct assign_
         {
-            constexpr types::memory_t
-                operator()(types::memory_t, types::memory_t b) noexcept
+            constexpr Word operator()(Word, Word b) noexcept
             {
                 return b;
             }
@@ -572,12 +802,11 @@ class minimal_bitset
     }
 
     template<std::size_t N>
-    constexpr minimal_bitset& operator&=(const minimal_bitset<N>& other) noexcept
+    constexpr minimal_bitset& operator&=(const minimal_bitset<N, Word>& other) noexcept
     {
         struct and_
         {
-            constexpr types::memory_t
-                operator()(types::memory_t a, types::memory_t b) noexcept
+            constexpr Word operator()(Word a, Word b) noexcept
             {
                 return a & b;
             }
@@ -587,12 +816,11 @@ class minimal_bitset
     }
 
     template<std::size_t N>
-    constexpr minimal_bitset& operator|=(const minimal_bitset<N>& other) noexcept
+    constexpr minimal_bitset& operator|=(const minimal_bitset<N, Word>& other) noexcept
     {
         struct or_
         {
-            constexpr types::memory_t
-                operator()(types::memory_t a, types::memory_t b) noexcept
+            constexpr Word operator()(Word a, Word b) noexcept
             {
                 return a | b;
             }
@@ -602,12 +830,11 @@ class minimal_bitset
     }
 
     template<std::size_t N>
-    constexpr minimal_bitset& operator^=(const minimal_bitset<N>& other) noexcept
+    constexpr minimal_bitset& operator^=(const minimal_bitset<N, Word>& other) noexcept
     {
         struct xor_
         {
-            constexpr types::memory_t
-                operator()(types::memory_t a, types::memory_t b) noexcept
+            constexpr Word operator()(Word a, Word b) noexcept
             {
                 return a ^ b;
             }
@@ -619,13 +846,7 @@ class minimal_bitset
     constexpr minimal_bitset operator~() const noexcept
     {
         auto tmp_ = *this;
-        for (size_type i{0}; i + 1 < CAPACITY; ++i)
-        {
-            tmp_.m_bytes[i] ^= BYTE_MASK;
-        }
-        tmp_.m_bytes[CAPACITY-1] =
-            (~tmp_.m_bytes[CAPACITY-1] & LAST_MASK) |
-            (tmp_.m_bytes[CAPACITY-1] & ~LAST_MASK);
+        tmp_.flip();
         return tmp_;
     }
 
@@ -641,30 +862,31 @@ class minimal_bitset
         {
             return *this;
         }
-        const size_type shifts_[] =
-            {position % BITS_IN_BYTE, BITS_IN_BYTE - (position % BITS_IN_BYTE)};
-        const size_type offsets_[] =
-            {position / BITS_IN_BYTE, (position + BITS_IN_BYTE-1) / BITS_IN_BYTE};
-        //! For >> we assume that operation zero-fills bytes for unsigned types
-        //! Otherwise the masking is needed
-        static_assert(decltype(m_bytes[0]){0} << 1 == 0, "");
-        static_assert((decltype(m_bytes[0]){~0} >> 1) != decltype(m_bytes[0]){~0}, "");
+        const size_type offset_ = position / BITS_IN_WORD;
+        const size_type shift_ = position % BITS_IN_WORD;
         //? Swiping from the end to beginning
-        m_bytes[LENGTH_] =
-            (((m_bytes[LENGTH_ - offsets_[1]] >> shifts_[1]) |
-              (m_bytes[LENGTH_ - offsets_[0]] << shifts_[0])) & LAST_MASK) |
-              (m_bytes[LENGTH_] & ~LAST_MASK);
-        for (size_type i{LENGTH_-1}; i > offsets_[0]; --i)
+        if (shift_ == 0)
         {
-            m_bytes[i] =
-                (m_bytes[i - offsets_[1]] >> shifts_[1]) |
-                (m_bytes[i - offsets_[0]] << shifts_[0]);
+            for (size_type i{LENGTH_}; i > offset_; --i)
+            {
+                m_words[i] = m_words[i - offset_];
+            }
         }
-        m_bytes[offsets_[0]] = m_bytes[0] << offsets_[0];
-        for (ssize_type i{offsets_[0] - 1}; i >= 0; --i)
+        else
         {
-            m_bytes[i] = 0;
+            for (size_type i{LENGTH_}; i > offset_; --i)
+            {
+                m_words[i] = static_cast<Word>(
+                    (m_words[i - offset_] << shift_) |
+                    (m_words[i - offset_ - 1] >> (BITS_IN_WORD - shift_)));
+            }
         }
+        m_words[offset_] = static_cast<Word>(m_words[0] << shift_);
+        for (size_type i{0}; i < offset_; ++i)
+        {
+            m_words[i] = 0;
+        }
+        m_words[LENGTH_] &= LAST_MASK;
         return *this;
     }
 
@@ -686,26 +908,28 @@ class minimal_bitset
         {
             return *this;
         }
-        const size_type shifts_[] =
-            {position % BITS_IN_BYTE, BITS_IN_BYTE - (position % BITS_IN_BYTE)};
-        const size_type offsets_[] =
-            {position / BITS_IN_BYTE, (position + BITS_IN_BYTE-1) / BITS_IN_BYTE};
-        for (size_type i{0}; i + offsets_[1] < LENGTH_; ++i)
+        const size_type offset_ = position / BITS_IN_WORD;
+        const size_type shift_ = position % BITS_IN_WORD;
+        if (shift_ == 0)
         {
-            m_bytes[i] =
-                (m_bytes[i + offsets_[0]] >> shifts_[0]) |
-                (m_bytes[i + offsets_[1]] << shifts_[1]);
+            for (size_type i{0}; i + offset_ < LENGTH_; ++i)
+            {
+                m_words[i] = m_words[i + offset_];
+            }
         }
-        m_bytes[LENGTH_ - offsets_[1]] =
-            (m_bytes[LENGTH_ - offsets_[1] + offsets_[0]] >> shifts_[0]) |
-            ((m_bytes[LENGTH_] & LAST_MASK) << shifts_[1]);
-        for (ssize_type i{LENGTH_ - offsets_[1] + 1}; i < LENGTH_; ++i)
+        else
         {
-            m_bytes[i] = 0;
+            for (size_type i{0}; i + offset_ < LENGTH_; ++i)
+            {
+                m_words[i] = static_cast<Word>(
+                    (m_words[i + offset_] >> shift_) |
+                    (m_words[i + offset_ + 1] << (BITS_IN_WORD - shift_)));
+            }
         }
-        if (position > LAST_BIT)
+        m_words[LENGTH_ - offset_] = static_cast<Word>(m_words[LENGTH_] >> shift_);
+        for (size_type i{LENGTH_ - offset_ + 1}; i <= LENGTH_; ++i)
         {
-            m_bytes[LENGTH_] &= ~LAST_MASK;
+            m_words[i] = 0;
         }
         return *this;
     }
@@ -716,37 +940,40 @@ class minimal_bitset
         return tmp_ >>= position;
     }
 
-    constexpr bool operator==(const minimal_bitset& rhs) noexcept
+    constexpr bool operator==(const minimal_bitset& rhs) const noexcept
     {
-        for (size_type i{0}; i + 1 < CAPACITY; ++i)
+        for (size_type i{0}; i < CAPACITY; ++i)
         {
-            if (m_bytes[i] != rhs.m_bytes[i])
+            if (m_words[i] != rhs.m_words[i])
             {
                 return false;
             }
         }
-        return (m_bytes[CAPACITY-1] & LAST_MASK) == (rhs.m_bytes[CAPACITY-1] & LAST_MASK);
+        return true;
     }
-    constexpr bool operator!=(const minimal_bitset& rhs) noexcept
+    constexpr bool operator!=(const minimal_bitset& rhs) const noexcept
     {
         return !(*this == rhs);
     }
 };
 
-template<std::size_t N>
-minimal_bitset<N> operator&(const minimal_bitset<N>& lhs, const minimal_bitset<N>& rhs) noexcept
+template<std::size_t N, class W>
+constexpr minimal_bitset<N, W> operator&(
+    const minimal_bitset<N, W>& lhs, const minimal_bitset<N, W>& rhs) noexcept
 {
     auto tmp_ = lhs;
     return tmp_ &= rhs;
 }
-template<std::size_t N>
-minimal_bitset<N> operator|(const minimal_bitset<N>& lhs, const minimal_bitset<N>& rhs) noexcept
+template<std::size_t N, class W>
+constexpr minimal_bitset<N, W> operator|(
+    const minimal_bitset<N, W>& lhs, const minimal_bitset<N, W>& rhs) noexcept
 {
     auto tmp_ = lhs;
     return tmp_ |= rhs;
 }
-template<std::size_t N>
-minimal_bitset<N> operator^(const minimal_bitset<N>& lhs, const minimal_bitset<N>& rhs) noexcept
+template<std::size_t N, class W>
+constexpr minimal_bitset<N, W> operator^(
+    const minimal_bitset<N, W>& lhs, const minimal_bitset<N, W>& rhs) noexcept
 {
     auto tmp_ = lhs;
     return tmp_ ^= rhs;
@@ -754,8 +981,9 @@ minimal_bitset<N> operator^(const minimal_bitset<N>& lhs, const minimal_bitset<N
 
 } // namespace containers
 
-template<std::size_t N>
-using minimal_bitset_t = containers::minimal_bitset<N>;
+template<std::size_t N,
+    class Word = containers::detail::minimal_bitset::default_word_t<N>>
+using minimal_bitset_t = containers::minimal_bitset<N, Word>;
 
 } // namespace ecsl
-#endif /* ECSL_CONTAINERS_MINIMAL_BITSET_HPP_ */
\ No newline at end of file
+#endif /* ECSL_CONTAINERS_MINIMAL_BITSET_HPP_ */
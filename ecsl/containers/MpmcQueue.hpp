@@ -0,0 +1,283 @@
+#ifndef ECSL_CONTAINERS_MPMC_QUEUE_HPP_
+#define ECSL_CONTAINERS_MPMC_QUEUE_HPP_
+
+/**
+ * @file MpmcQueue.hpp
+ * Declares bounded lock-free multi producer multi consumer array queue
+ *
+ * Every slot carries a sequence counter that tells whose turn it is:
+ *  sequence == position         - free for the producer of position
+ *  sequence == position + 1     - holds the element for the consumer
+ *  sequence == position + size  - free for the producer of the next lap
+ * A producer (consumer) claims a position with one CAS on the tail (head)
+ * index only after it saw the slot ready, so the indices are the only
+ * contended data and a full (empty) queue is detected without writes.
+ * Producers and consumers then work on different slots in parallel.
+ * The head and the tail are on separate cache lines.
+ *
+ * Sources:
+ *  D. Vyukov "Bounded MPMC queue"
+ *  https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+
+/// STD
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+/// ECSL
+#include <ecsl/containers/detail/Concurrency.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace mpmc_queue {
+
+template<class T>
+struct slot
+{
+    std::atomic<std::size_t> m_sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+
+    inline T* value() noexcept
+    {
+        return reinterpret_cast<T*>(&m_storage);
+    }
+};
+
+} // namespace mpmc_queue
+} // namespace detail
+
+/**
+ * @brief Bounded lock-free queue for any count of producers and consumers
+ * try_push/try_pop fail immediately on full/empty queue, push/pop spin and
+ * then back off (yield) until they succeed.
+ */
+template<class T>
+class mpmc_queue
+{
+    static_assert(std::is_nothrow_destructible<T>::value,
+        "mpmc_queue requires nothrow destructible elements");
+
+    static constexpr std::size_t CACHE_LINE_SIZE = detail::concurrency::CACHE_LINE_SIZE;
+
+    using slot_t = detail::mpmc_queue::slot<T>;
+
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+
+  private:
+    //? Read only after construction
+    alignas(CACHE_LINE_SIZE) slot_t* m_slots;
+    size_type m_mask;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_type> m_tail;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_type> m_head;
+
+    static size_type capacity_for_(size_type capacity)
+    {
+        if (capacity == 0 || capacity > (~size_type{0} >> 1) / sizeof(slot_t))
+        {
+            throw std::length_error{"mpmc_queue length error"};
+        }
+        size_type r_{2};
+        while (r_ < capacity)
+        {
+            r_ <<= 1;
+        }
+        return r_;
+    }
+
+    static inline std::ptrdiff_t distance_(size_type sequence, size_type position) noexcept
+    {
+        return static_cast<std::ptrdiff_t>(sequence - position);
+    }
+
+    /**
+     * Claims the slot of the next position to write or nullptr if full
+     */
+    slot_t* claim_push_(size_type& position) noexcept
+    {
+        position = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto* slot_ = m_slots + (position & m_mask);
+            const auto d_ = distance_(slot_->m_sequence.load(std::memory_order_acquire), position);
+            if (d_ == 0)
+            {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    return slot_;
+                }
+            }
+            else if (d_ < 0)
+            {   //? The consumer of the previous lap did not free the slot yet
+                return nullptr;
+            }
+            else
+            {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Claims the slot of the next position to read or nullptr if empty
+     */
+    slot_t* claim_pop_(size_type& position) noexcept
+    {
+        position = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto* slot_ = m_slots + (position & m_mask);
+            const auto d_ = distance_(slot_->m_sequence.load(std::memory_order_acquire), position + 1);
+            if (d_ == 0)
+            {
+                if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    return slot_;
+                }
+            }
+            else if (d_ < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                position = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<class ... Args>
+    inline void publish_(slot_t* slot, size_type position, Args&& ... args) noexcept
+    {
+        ::new(static_cast<void*>(slot->value())) T(std::forward<Args>(args)...);
+        slot->m_sequence.store(position + 1, std::memory_order_release);
+    }
+
+    inline void consume_(slot_t* slot, size_type position, T& value) noexcept
+    {
+        value = std::move(*slot->value());
+        slot->value()->~T();
+        slot->m_sequence.store(position + m_mask + 1, std::memory_order_release);
+    }
+
+  public:
+    /**
+     * @brief Queue of at least capacity slots rounded up to a power of two (>= 2)
+     */
+    explicit mpmc_queue(size_type capacity) :
+        m_slots{nullptr}, m_mask{capacity_for_(capacity) - 1}, m_tail{0}, m_head{0}
+    {
+        m_slots = std::allocator<slot_t>{}.allocate(m_mask + 1);
+        for (size_type i{0}; i <= m_mask; ++i)
+        {
+            ::new(static_cast<void*>(m_slots + i)) slot_t;
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue()
+    {
+        const auto tail_ = m_tail.load(std::memory_order_relaxed);
+        for (auto i = m_head.load(std::memory_order_relaxed); i != tail_; ++i)
+        {
+            m_slots[i & m_mask].value()->~T();
+        }
+        std::allocator<slot_t>{}.deallocate(m_slots, m_mask + 1);
+    }
+
+    inline size_type capacity() const noexcept { return m_mask + 1; }
+
+    /**
+     * @brief Approximate count of elements (exact when the queue is idle)
+     */
+    inline size_type size() const noexcept
+    {
+        const auto head_ = m_head.load(std::memory_order_acquire);
+        const auto tail_ = m_tail.load(std::memory_order_acquire);
+        return distance_(tail_, head_) > 0 ? tail_ - head_ : 0;
+    }
+
+    inline bool empty() const noexcept { return size() == 0; }
+
+    /* Non-blocking */
+
+    /**
+     * @brief Constructs the element in place, T must be nothrow constructible
+     * from args (a claimed slot can not be given back)
+     */
+    template<class ... Args>
+    bool try_emplace(Args&& ... args) noexcept
+    {
+        static_assert(std::is_nothrow_constructible<T, Args&&...>::value,
+            "mpmc_queue requires nothrow construction of elements");
+        size_type position_;
+        if (auto* slot_ = claim_push_(position_))
+        {
+            publish_(slot_, position_, std::forward<Args>(args)...);
+            return true;
+        }
+        return false;
+    }
+
+    inline bool try_push(const T& value) noexcept { return try_emplace(value); }
+    inline bool try_push(T&& value) noexcept { return try_emplace(std::move(value)); }
+
+    bool try_pop(T& value) noexcept
+    {
+        static_assert(std::is_nothrow_move_assignable<T>::value,
+            "mpmc_queue requires nothrow move assignment of elements");
+        size_type position_;
+        if (auto* slot_ = claim_pop_(position_))
+        {
+            consume_(slot_, position_, value);
+            return true;
+        }
+        return false;
+    }
+
+    /* Blocking: spin, then back off */
+
+    template<class ... Args>
+    void emplace(Args&& ... args) noexcept
+    {
+        static_assert(std::is_nothrow_constructible<T, Args&&...>::value,
+            "mpmc_queue requires nothrow construction of elements");
+        detail::concurrency::backoff backoff_;
+        size_type position_;
+        slot_t* slot_;
+        while (!(slot_ = claim_push_(position_)))
+        {
+            backoff_();
+        }
+        publish_(slot_, position_, std::forward<Args>(args)...);
+    }
+
+    inline void push(const T& value) noexcept { emplace(value); }
+    inline void push(T&& value) noexcept { emplace(std::move(value)); }
+
+    void pop(T& value) noexcept
+    {
+        detail::concurrency::backoff backoff_;
+        while (!try_pop(value))
+        {
+            backoff_();
+        }
+    }
+};
+
+} // namespace containers
+
+template<class T>
+using mpmc_queue_t = containers::mpmc_queue<T>;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_MPMC_QUEUE_HPP_ */
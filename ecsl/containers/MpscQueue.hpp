@@ -0,0 +1,173 @@
+#ifndef ECSL_CONTAINERS_MPSC_QUEUE_HPP_
+#define ECSL_CONTAINERS_MPSC_QUEUE_HPP_
+
+/**
+ * @file MpscQueue.hpp
+ * Declares unbounded intrusive multi producer single consumer queue
+ *
+ * Elements derive from mpsc_queue_hook, so the queue never allocates and
+ * the element memory may come from anywhere (e.g. memory::object_pool).
+ * The queue is a singly linked list from the consumer end (head) to the
+ * producer end (tail):
+ *  push - one exchange of the tail and a store linking the previous tail,
+ *         wait-free for any count of producers
+ *  pop  - plain loads and stores of the consumer owned head, no CAS loop
+ * A stub hook owned by the queue is kept in the list when it runs empty,
+ * so the last element can be unlinked without touching the tail pointer.
+ * Between the exchange and the link of a push the list is broken: pop
+ * waits (spins, then yields) for the link when elements follow the head, so it
+ * returns nullptr only when the queue is empty or the only push in
+ * progress is the one of the first element. A push does not tell whether
+ * the consumer is idle, an actor scheduling its mailbox drain keeps its
+ * own scheduled flag and drains while (!empty()) after clearing it.
+ *
+ * Sources:
+ *  D. Vyukov "Intrusive MPSC node-based queue"
+ *  https://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+ */
+
+/// STD
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+/// ECSL
+#include <ecsl/containers/detail/Concurrency.hpp>
+
+namespace ecsl {
+namespace containers {
+
+/**
+ * @brief Base of elements of mpsc_queue
+ * An element can be in at most one queue at a time.
+ */
+class mpsc_queue_hook
+{
+    template<class T>
+    friend class mpsc_queue;
+
+    std::atomic<mpsc_queue_hook*> m_next{nullptr};
+
+  public:
+    mpsc_queue_hook() noexcept = default;
+    //? Hook state belongs to the queue, copies start unlinked
+    mpsc_queue_hook(const mpsc_queue_hook&) noexcept : m_next{nullptr} {}
+    mpsc_queue_hook& operator=(const mpsc_queue_hook&) noexcept { return *this; }
+};
+
+/**
+ * @brief Unbounded intrusive queue for any count of producers and one
+ * consumer thread. Producer side: push. Consumer side: pop, empty.
+ * The queue does not own the elements, they must outlive their stay in it.
+ * @tparam T Element type derived from mpsc_queue_hook
+ */
+template<class T>
+class mpsc_queue
+{
+    static constexpr std::size_t CACHE_LINE_SIZE = detail::concurrency::CACHE_LINE_SIZE;
+
+    using hook_t = mpsc_queue_hook;
+
+  public:
+    using value_type    = T;
+    using pointer       = T*;
+
+  private:
+    //? Producers
+    alignas(CACHE_LINE_SIZE) std::atomic<hook_t*> m_tail;
+    //? Consumer
+    alignas(CACHE_LINE_SIZE) hook_t* m_head;
+    hook_t m_stub;
+
+    static inline pointer element_(hook_t* hook) noexcept
+    {
+        return static_cast<pointer>(hook);
+    }
+
+    inline void link_(hook_t* hook) noexcept
+    {
+        hook->m_next.store(nullptr, std::memory_order_relaxed);
+        auto* prev_ = m_tail.exchange(hook, std::memory_order_acq_rel);
+        //? The list is broken at prev_ until this store, see pop()
+        prev_->m_next.store(hook, std::memory_order_release);
+    }
+
+    /**
+     * Next of a hook that is not the tail, its producer may not have linked
+     * it yet but is past the exchange (a couple of instructions)
+     */
+    static inline hook_t* wait_next_(hook_t* hook) noexcept
+    {
+        //? The producer may be preempted right after the exchange
+        detail::concurrency::backoff backoff_;
+        hook_t* next_;
+        while (!(next_ = hook->m_next.load(std::memory_order_acquire)))
+        {
+            backoff_();
+        }
+        return next_;
+    }
+
+  public:
+    mpsc_queue() noexcept : m_tail{&m_stub}, m_head{&m_stub}, m_stub{} {}
+
+    mpsc_queue(const mpsc_queue&) = delete;
+    mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+    /**
+     * @brief Appends the element, wait-free
+     */
+    inline void push(pointer value) noexcept
+    {
+        static_assert(std::is_base_of<hook_t, T>::value,
+            "mpsc_queue requires elements derived from mpsc_queue_hook");
+        link_(value);
+    }
+
+    /**
+     * @brief Unlinks the oldest element or returns nullptr if the queue is
+     * empty (or its first element is being pushed)
+     */
+    pointer pop() noexcept
+    {
+        auto* head_ = m_head;
+        auto* next_ = head_->m_next.load(std::memory_order_acquire);
+        if (head_ == &m_stub)
+        {
+            if (!next_)
+            {
+                return nullptr;
+            }
+            m_head = head_ = next_;
+            next_ = next_->m_next.load(std::memory_order_acquire);
+        }
+        if (next_)
+        {
+            m_head = next_;
+            return element_(head_);
+        }
+        if (head_ == m_tail.load(std::memory_order_acquire))
+        {   //? head_ is the last element, put the stub behind it to unlink it
+            link_(&m_stub);
+        }
+        //? Either the stub or a producer that exchanged the tail follows head_
+        m_head = wait_next_(head_);
+        return element_(head_);
+    }
+
+    /**
+     * @brief Checks whether there are no elements, exact only from consumer
+     * when no push is in progress
+     */
+    inline bool empty() const noexcept
+    {
+        return m_head == &m_stub && !m_stub.m_next.load(std::memory_order_acquire);
+    }
+};
+
+} // namespace containers
+
+template<class T>
+using mpsc_queue_t = containers::mpsc_queue<T>;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_MPSC_QUEUE_HPP_ */
@@ -0,0 +1,320 @@
+#ifndef ECSL_CONTAINERS_RANK_SELECT_HPP_
+#define ECSL_CONTAINERS_RANK_SELECT_HPP_
+
+/**
+ * @file RankSelect.hpp
+ * Declares rank/select index over a static bit vector of 64-bit words
+ *
+ * The index does not own the bits: the words must outlive the index and
+ * must not change after construction (rebuild the index otherwise).
+ *
+ * Layout (Poppy, about 3.5% of the bit vector):
+ *  L0 - set bits before every 2^32 bits (64 bits per 2^32 bits)
+ *  L1 - one 64-bit entry per 2048 bits: set bits before the block within
+ *       its L0 range (32 bits) and the counts of the first three 512-bit
+ *       basic blocks (3 x 10 bits), 3.125%
+ *  samples - L1 block of every 8192-th set bit (32 bits), at most 0.4%
+ * rank() reads one L1 entry and at most 8 words of one cache line,
+ * select() narrows the L1 blocks between two samples, picks the basic
+ * block and word by counts and the bit in the word with pdep (BMI2).
+ *
+ * Sources:
+ *  D. Zhou, D. G. Andersen, M. Kaminsky "Space-Efficient, High-Performance
+ *  Rank & Select Structures on Uncompressed Bit Sequences" SEA 2013
+ *  P. Pandey, M. A. Bender, R. Johnson "A Fast x86 Implementation of Select"
+ *  https://arxiv.org/abs/1706.00990
+ */
+
+/// STD
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+/// ECSL
+#include <ecsl/containers/DynamicBitset.hpp>
+#include <ecsl/containers/MinimalBitset.hpp>
+#include <ecsl/platform/CpuFeatures.hpp>
+#include <ecsl/platform/Simd.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace rank_select {
+
+using word_t = std::uint64_t;
+
+/**
+ * Position of the k-th (from 0) set bit of the word, k < popcount(word)
+ */
+inline std::size_t select_in_word_portable_(word_t word, std::size_t k) noexcept
+{
+    std::size_t r_{0};
+    //? Whole bytes first, then bits of the byte
+    for (auto count_ = minimal_bitset::popcount_(word & 0xFF); k >= count_;
+         count_ = minimal_bitset::popcount_(word & 0xFF))
+    {
+        k -= count_;
+        word >>= CHAR_BIT;
+        r_ += CHAR_BIT;
+    }
+    for (; k; --k)
+    {
+        word &= word - 1;
+    }
+    return r_ + minimal_bitset::lowest_bit_(word);
+}
+
+#if defined(ECSL_SIMD_DISPATCH)
+
+ECSL_SIMD_TARGET("bmi,bmi2")
+inline std::size_t select_in_word_bmi2_(word_t word, std::size_t k) noexcept
+{
+    return static_cast<std::size_t>(_tzcnt_u64(_pdep_u64(word_t{1} << k, word)));
+}
+
+#endif /* ECSL_SIMD_DISPATCH */
+
+inline std::size_t select_in_word(word_t word, std::size_t k) noexcept
+{
+#if defined(ECSL_SIMD_BMI2) && defined(ECSL_SIMD_DISPATCH)
+    return select_in_word_bmi2_(word, k);
+#else
+#if defined(ECSL_SIMD_DISPATCH)
+    if (runtime_cpu_features().bmi2)
+    {
+        return select_in_word_bmi2_(word, k);
+    }
+#endif
+    return select_in_word_portable_(word, k);
+#endif
+}
+
+} // namespace rank_select
+} // namespace detail
+
+/**
+ * @brief Constant time rank and near constant time select over external bits
+ */
+class rank_select
+{
+  public:
+    using word_type     = std::uint64_t;
+    using size_type     = std::size_t;
+
+    static constexpr size_type BITS_IN_WORD = sizeof(word_type) * CHAR_BIT;
+    static constexpr size_type BASIC_BITS = 512;
+    static constexpr size_type BLOCK_BITS = 2048;
+    static constexpr size_type SUPER_BITS = size_type{1} << 32;
+    static constexpr size_type SAMPLE_RATE = 8192;
+
+  private:
+    static constexpr size_type BASIC_WORDS = BASIC_BITS / BITS_IN_WORD;
+    static constexpr size_type BLOCK_WORDS = BLOCK_BITS / BITS_IN_WORD;
+    static constexpr size_type BLOCKS_IN_SUPER = SUPER_BITS / BLOCK_BITS;
+    static constexpr size_type BASIC_COUNT_BITS = 10;
+    static constexpr word_type BASIC_COUNT_MASK = (word_type{1} << BASIC_COUNT_BITS) - 1;
+
+    const word_type* m_words;
+    size_type m_bits;
+    size_type m_ones;
+    std::vector<std::uint64_t> m_l0;
+    std::vector<std::uint64_t> m_l1;
+    std::vector<std::uint32_t> m_samples;
+
+    inline word_type word_(size_type word) const noexcept
+    {   //? Bits past size() are masked out
+        return word + 1 < (m_bits + BITS_IN_WORD - 1) / BITS_IN_WORD || !(m_bits % BITS_IN_WORD) ?
+            m_words[word] : m_words[word] & ((word_type{1} << (m_bits % BITS_IN_WORD)) - 1);
+    }
+
+    /**
+     * Set bits before the L1 block
+     */
+    inline size_type block_rank_(size_type block) const noexcept
+    {
+        return m_l0[block / BLOCKS_IN_SUPER] + (m_l1[block] & 0xFFFFFFFFu);
+    }
+
+    inline static size_type basic_count_(word_type entry, size_type basic) noexcept
+    {
+        return (entry >> (32 + BASIC_COUNT_BITS * basic)) & BASIC_COUNT_MASK;
+    }
+
+    void build_()
+    {
+        const auto words_ = (m_bits + BITS_IN_WORD - 1) / BITS_IN_WORD;
+        const auto blocks_ = (words_ + BLOCK_WORDS - 1) / BLOCK_WORDS;
+        m_l0.reserve(blocks_ / BLOCKS_IN_SUPER + 1);
+        m_l1.reserve(blocks_);
+        for (size_type b{0}; b < blocks_; ++b)
+        {
+            if (b % BLOCKS_IN_SUPER == 0)
+            {
+                m_l0.push_back(m_ones);
+            }
+            auto entry_ = static_cast<word_type>(m_ones - m_l0.back());
+            size_type block_ones_{0};
+            for (size_type basic{0}; basic < BLOCK_WORDS / BASIC_WORDS; ++basic)
+            {
+                size_type basic_ones_{0};
+                for (size_type w{0}; w < BASIC_WORDS; ++w)
+                {
+                    const auto word_index_ = b * BLOCK_WORDS + basic * BASIC_WORDS + w;
+                    basic_ones_ += word_index_ < words_ ?
+                        detail::minimal_bitset::popcount_(word_(word_index_)) : 0;
+                }
+                if (basic + 1 < BLOCK_WORDS / BASIC_WORDS)
+                {
+                    entry_ |= static_cast<word_type>(basic_ones_) <<
+                        (32 + BASIC_COUNT_BITS * basic);
+                }
+                block_ones_ += basic_ones_;
+            }
+            m_l1.push_back(entry_);
+            //? Every multiple of SAMPLE_RATE in [m_ones, m_ones + block_ones_) is in block b
+            for (auto k_ = (m_ones + SAMPLE_RATE - 1) / SAMPLE_RATE * SAMPLE_RATE;
+                 k_ < m_ones + block_ones_; k_ += SAMPLE_RATE)
+            {
+                m_samples.push_back(static_cast<std::uint32_t>(b));
+            }
+            m_ones += block_ones_;
+        }
+    }
+
+  public:
+    /**
+     * @brief Builds the index over bits [0, bits) of words
+     * Bits past bits in the last word are ignored.
+     */
+    rank_select(const word_type* words, size_type bits) :
+        m_words{words}, m_bits{bits}, m_ones{0}
+    {
+        build_();
+    }
+
+    explicit rank_select(const dynamic_bitset& bits) :
+        rank_select(bits.data(), bits.size())
+    {}
+
+    template<std::size_t N>
+    explicit rank_select(const minimal_bitset<N, word_type>& bits) :
+        rank_select(bits.data(), bits.size())
+    {}
+
+    //? The index refers to the bits of its argument, not to a temporary copy
+    explicit rank_select(dynamic_bitset&&) = delete;
+    template<std::size_t N>
+    explicit rank_select(minimal_bitset<N, word_type>&&) = delete;
+
+    inline size_type size() const noexcept { return m_bits; }
+
+    /**
+     * @brief Count of set bits
+     */
+    inline size_type count() const noexcept { return m_ones; }
+
+    /**
+     * @brief Memory used by the index in bytes (the bits are not counted)
+     */
+    inline size_type index_bytes() const noexcept
+    {
+        return m_l0.size() * sizeof(m_l0[0]) + m_l1.size() * sizeof(m_l1[0]) +
+            m_samples.size() * sizeof(m_samples[0]);
+    }
+
+    /**
+     * @brief Count of set bits in [0, position)
+     * Positions past size() are clamped to size().
+     */
+    size_type rank(size_type position) const noexcept
+    {
+        if (position >= m_bits)
+        {
+            return m_ones;
+        }
+        const auto block_ = position / BLOCK_BITS;
+        const auto basic_ = position % BLOCK_BITS / BASIC_BITS;
+        const auto entry_ = m_l1[block_];
+        auto r_ = block_rank_(block_);
+        for (size_type i{0}; i < basic_; ++i)
+        {
+            r_ += basic_count_(entry_, i);
+        }
+        const auto last_ = position / BITS_IN_WORD;
+        for (auto w = block_ * BLOCK_WORDS + basic_ * BASIC_WORDS; w < last_; ++w)
+        {
+            r_ += detail::minimal_bitset::popcount_(m_words[w]);
+        }
+        if (position % BITS_IN_WORD)
+        {
+            r_ += detail::minimal_bitset::popcount_(
+                m_words[last_] & ((word_type{1} << (position % BITS_IN_WORD)) - 1));
+        }
+        return r_;
+    }
+
+    /**
+     * @brief Count of zero bits in [0, position)
+     */
+    inline size_type rank0(size_type position) const noexcept
+    {
+        return std::min(position, m_bits) - rank(position);
+    }
+
+    /**
+     * @brief Position of the k-th (counting from 0) set bit or size() if k >= count()
+     */
+    size_type select(size_type k) const noexcept
+    {
+        if (k >= m_ones)
+        {
+            return m_bits;
+        }
+        //? The last block not after k-th bit: between two samples
+        const auto sample_ = k / SAMPLE_RATE;
+        size_type lo_{m_samples[sample_]};
+        size_type hi_{sample_ + 1 < m_samples.size() ? m_samples[sample_ + 1] : m_l1.size() - 1};
+        while (lo_ < hi_)
+        {
+            const auto mid_ = lo_ + (hi_ - lo_ + 1) / 2;
+            if (block_rank_(mid_) <= k)
+            {
+                lo_ = mid_;
+            }
+            else
+            {
+                hi_ = mid_ - 1;
+            }
+        }
+        k -= block_rank_(lo_);
+        const auto entry_ = m_l1[lo_];
+        size_type basic_{0};
+        for (; basic_ + 1 < BLOCK_WORDS / BASIC_WORDS; ++basic_)
+        {
+            const auto count_ = basic_count_(entry_, basic_);
+            if (k < count_)
+            {
+                break;
+            }
+            k -= count_;
+        }
+        auto w_ = lo_ * BLOCK_WORDS + basic_ * BASIC_WORDS;
+        for (;; ++w_)
+        {
+            const auto count_ = detail::minimal_bitset::popcount_(m_words[w_]);
+            if (k < count_)
+            {
+                break;
+            }
+            k -= count_;
+        }
+        return w_ * BITS_IN_WORD + detail::rank_select::select_in_word(m_words[w_], k);
+    }
+};
+
+} // namespace containers
+
+using rank_select_t = containers::rank_select;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_RANK_SELECT_HPP_ */
@@ -0,0 +1,1407 @@
+#ifndef ECSL_CONTAINERS_ROARING_BITMAP_HPP_
+#define ECSL_CONTAINERS_ROARING_BITMAP_HPP_
+
+/**
+ * @file RoaringBitmap.hpp
+ * Declares compressed bitmap of 32-bit values (Roaring bitmap)
+ *
+ * Values are split by the high 16 bits into chunks of 2^16 values, every
+ * chunk is kept in one of three containers:
+ *  array  - sorted 16-bit values, at most 4096 of them (up to 8 KiB)
+ *  bitmap - 1024 64-bit words (8 KiB), for more than 4096 values
+ *  run    - sorted (start, length - 1) pairs of 16-bit values
+ * add() turns a full array into a bitmap, remove() turns a bitmap back into
+ * an array when it gets half full (the hysteresis stops add/remove ping-pong
+ * at the boundary). Set operations produce arrays or bitmaps, optimize()
+ * chooses the smallest container for every chunk including runs.
+ *
+ * Array intersection compares blocks of 8 values with all 8 rotations of
+ * the other block (SSSE3) and gallops through the larger array when sizes
+ * differ by 64 times; bitmap kernels are the dynamic_bitset ones.
+ *
+ * Serialized form is little-endian and is read in place by roaring_view,
+ * a.e. straight from a memory mapped file:
+ *  u32 magic "ECRB", u32 chunk count
+ *  chunk count descriptors of u16 key, u16 type, u32 cardinality,
+ *      u32 length (in 16-bit units), u32 offset (from the start)
+ *  payloads: array - values, run - (start, length - 1) pairs,
+ *      bitmap - 1024 u64 words at 8-byte aligned offset
+ *
+ * Sources:
+ *  D. Lemire, G. Ssi-Yan-Kai, O. Kaser "Consistently faster and smaller
+ *  compressed bitmaps with Roaring" https://arxiv.org/abs/1603.06549
+ *  B. Schlegel, T. Willhalm, W. Lehner "Fast Sorted-Set Intersection using
+ *  SIMD Instructions" ADMS 2011
+ */
+
+/// STD
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+/// ECSL
+#include <ecsl/containers/DynamicBitset.hpp>
+#include <ecsl/containers/MinimalBitset.hpp>
+#include <ecsl/platform/CpuFeatures.hpp>
+#include <ecsl/platform/Simd.hpp>
+#include <ecsl/type_traits/SimpleTypes.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace roaring {
+
+using low_t  = std::uint16_t;
+using word_t = dynamic_bitset::word_t;
+
+constexpr std::size_t CHUNK_VALUES = std::size_t{1} << (sizeof(low_t) * CHAR_BIT);
+constexpr std::size_t ARRAY_MAX = 4096;
+constexpr std::size_t BITS_IN_WORD = sizeof(word_t) * CHAR_BIT;
+constexpr std::size_t BITMAP_WORDS = CHUNK_VALUES / BITS_IN_WORD;
+
+enum class chunk_type : std::uint16_t
+{
+    ARRAY,
+    BITMAP,
+    RUN,
+};
+
+template<class T>
+inline T load_le(const types::memory_t* src) noexcept
+{
+    T r_{0};
+    for (std::size_t i{0}; i < sizeof(T); ++i)
+    {
+        r_ |= static_cast<T>(static_cast<T>(src[i]) << (CHAR_BIT * i));
+    }
+    return r_;
+}
+
+template<class T>
+inline void store_le(types::memory_t* dst, T value) noexcept
+{
+    for (std::size_t i{0}; i < sizeof(T); ++i)
+    {
+        dst[i] = static_cast<types::memory_t>(value >> (CHAR_BIT * i));
+    }
+}
+
+/* Sorted array intersection: out must have room for min(na, nb) + 8 values */
+
+struct shuffle_t
+{
+    alignas(16) signed char m_data[16];
+};
+
+struct shuffles_t
+{
+    shuffle_t m_data[256];
+};
+
+//? Moves the 16-bit lanes selected by the mask to the front
+constexpr shuffles_t make_pack() noexcept
+{
+    shuffles_t r_{};
+    for (unsigned mask{0}; mask < 256; ++mask)
+    {
+        unsigned k_{0};
+        for (unsigned lane{0}; lane < 8; ++lane)
+        {
+            if (mask & (1u << lane))
+            {
+                r_.m_data[mask].m_data[2 * k_] = static_cast<signed char>(2 * lane);
+                r_.m_data[mask].m_data[2 * k_ + 1] = static_cast<signed char>(2 * lane + 1);
+                ++k_;
+            }
+        }
+        for (; k_ < 8; ++k_)
+        {
+            r_.m_data[mask].m_data[2 * k_] = -1;
+            r_.m_data[mask].m_data[2 * k_ + 1] = -1;
+        }
+    }
+    return r_;
+}
+
+struct tables
+{
+    static constexpr shuffles_t PACK = make_pack();
+};
+
+inline std::size_t intersect_scalar_(const low_t* a, std::size_t na,
+    const low_t* b, std::size_t nb, low_t* out) noexcept
+{
+    std::size_t i_{0}, j_{0}, r_{0};
+    while (i_ < na && j_ < nb)
+    {
+        if (a[i_] < b[j_])
+        {
+            ++i_;
+        }
+        else if (b[j_] < a[i_])
+        {
+            ++j_;
+        }
+        else
+        {
+            out[r_++] = a[i_++];
+            ++j_;
+        }
+    }
+    return r_;
+}
+
+/**
+ * Exponential search of every value of the small array in the large one
+ */
+inline std::size_t intersect_galloping_(const low_t* small, std::size_t ns,
+    const low_t* large, std::size_t nl, low_t* out) noexcept
+{
+    const low_t* end_ = large + nl;
+    std::size_t r_{0};
+    for (std::size_t i{0}; i < ns && large != end_; ++i)
+    {
+        const auto value_ = small[i];
+        const auto left_ = static_cast<std::size_t>(end_ - large);
+        std::size_t step_{1};
+        //? large[step_ / 2] < value_ holds for step_ > 1
+        while (step_ < left_ && large[step_] < value_)
+        {
+            step_ <<= 1;
+        }
+        large = std::lower_bound(large + step_ / 2, large + std::min(step_ + 1, left_), value_);
+        if (large != end_ && *large == value_)
+        {
+            out[r_++] = value_;
+            ++large;
+        }
+    }
+    return r_;
+}
+
+#if defined(ECSL_SIMD_DISPATCH)
+
+ECSL_SIMD_TARGET("ssse3")
+inline std::size_t intersect_ssse3_(const low_t* a, std::size_t na,
+    const low_t* b, std::size_t nb, low_t* out) noexcept
+{
+    std::size_t i_{0}, j_{0}, r_{0};
+    while (i_ + 8 <= na && j_ + 8 <= nb)
+    {
+        const __m128i a_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i_));
+        const __m128i b_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j_));
+        //? Every value of a_ against every value of b_
+        __m128i eq_ = _mm_cmpeq_epi16(a_, b_);
+        eq_ = _mm_or_si128(eq_, _mm_cmpeq_epi16(a_, _mm_alignr_epi8(b_, b_, 2)));
+        eq_ = _mm_or_si128(eq_, _mm_cmpeq_epi16(a_, _mm_alignr_epi8(b_, b_, 4)));
+        eq_ = _mm_or_si128(eq_, _mm_cmpeq_epi16(a_, _mm_alignr_epi8(b_, b_, 6)));
+        eq_ = _mm_or_si128(eq_, _mm_cmpeq_epi16(a_, _mm_alignr_epi8(b_, b_, 8)));
+        eq_ = _mm_or_si128(eq_, _mm_cmpeq_epi16(a_, _mm_alignr_epi8(b_, b_, 10)));
+        eq_ = _mm_or_si128(eq_, _mm_cmpeq_epi16(a_, _mm_alignr_epi8(b_, b_, 12)));
+        eq_ = _mm_or_si128(eq_, _mm_cmpeq_epi16(a_, _mm_alignr_epi8(b_, b_, 14)));
+        const auto mask_ = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_packs_epi16(eq_, _mm_setzero_si128())));
+        const __m128i shuffle_ = _mm_load_si128(
+            reinterpret_cast<const __m128i*>(tables::PACK.m_data[mask_].m_data));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + r_), _mm_shuffle_epi8(a_, shuffle_));
+        r_ += minimal_bitset::popcount_(mask_);
+        //? The block with the smaller maximum can not match anything further
+        const low_t a_max_ = a[i_ + 7];
+        const low_t b_max_ = b[j_ + 7];
+        if (a_max_ <= b_max_)
+        {
+            i_ += 8;
+        }
+        if (b_max_ <= a_max_)
+        {
+            j_ += 8;
+        }
+    }
+    return r_ + intersect_scalar_(a + i_, na - i_, b + j_, nb - j_, out + r_);
+}
+
+#endif /* ECSL_SIMD_DISPATCH */
+
+/**
+ * Intersection of sorted arrays of unique values
+ * @return Count of values written to out
+ */
+inline std::size_t intersect(const low_t* a, std::size_t na,
+    const low_t* b, std::size_t nb, low_t* out) noexcept
+{
+    if (na > nb)
+    {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (na * 64 < nb)
+    {
+        return intersect_galloping_(a, na, b, nb, out);
+    }
+#if defined(ECSL_SIMD_SSSE3) && defined(ECSL_SIMD_DISPATCH)
+    return intersect_ssse3_(a, na, b, nb, out);
+#else
+#if defined(ECSL_SIMD_DISPATCH)
+    //? Every processor with SSE4.2 has SSSE3
+    if (runtime_cpu_features().sse4_2)
+    {
+        return intersect_ssse3_(a, na, b, nb, out);
+    }
+#endif
+    return intersect_scalar_(a, na, b, nb, out);
+#endif
+}
+
+/**
+ * Values sharing the high 16 bits
+ */
+struct chunk
+{
+    chunk_type m_type;
+    std::uint32_t m_cardinality;
+    //? ARRAY: sorted values, RUN: (start, length - 1) pairs
+    std::vector<low_t> m_values;
+    //? BITMAP: BITMAP_WORDS words
+    std::vector<word_t> m_words;
+
+    chunk() noexcept : m_type{chunk_type::ARRAY}, m_cardinality{0} {}
+
+    inline std::size_t runs() const noexcept { return m_values.size() / 2; }
+
+    //? Last value of the run (inclusive)
+    inline std::uint32_t run_end(std::size_t run) const noexcept
+    {
+        return std::uint32_t{m_values[2 * run]} + m_values[2 * run + 1];
+    }
+
+    /**
+     * Index of the run containing value or runs()
+     */
+    std::size_t find_run(low_t value) const noexcept
+    {
+        std::size_t lo_{0}, hi_{runs()};
+        while (lo_ < hi_)
+        {
+            const auto mid_ = (lo_ + hi_) / 2;
+            if (m_values[2 * mid_] <= value)
+            {
+                lo_ = mid_ + 1;
+            }
+            else
+            {
+                hi_ = mid_;
+            }
+        }
+        return lo_ && value <= run_end(lo_ - 1) ? lo_ - 1 : runs();
+    }
+
+    bool contains(low_t value) const noexcept
+    {
+        switch (m_type)
+        {
+            case chunk_type::ARRAY:
+                return std::binary_search(m_values.begin(), m_values.end(), value);
+            case chunk_type::BITMAP:
+                return (m_words[value / BITS_IN_WORD] >> (value % BITS_IN_WORD)) & 1;
+            default:
+                return find_run(value) != runs();
+        }
+    }
+
+    /**
+     * Calls f for every value in increasing order
+     */
+    template<class F>
+    void for_each(F&& f) const
+    {
+        switch (m_type)
+        {
+            case chunk_type::ARRAY:
+                for (const auto value : m_values)
+                {
+                    f(value);
+                }
+                break;
+            case chunk_type::BITMAP:
+                for (std::size_t w{0}; w < BITMAP_WORDS; ++w)
+                {
+                    for (auto bits_ = m_words[w]; bits_; bits_ &= bits_ - 1)
+                    {
+                        f(static_cast<low_t>(w * BITS_IN_WORD + minimal_bitset::lowest_bit_(bits_)));
+                    }
+                }
+                break;
+            default:
+                for (std::size_t i{0}; i < runs(); ++i)
+                {
+                    for (std::uint32_t v{m_values[2 * i]}; v <= run_end(i); ++v)
+                    {
+                        f(static_cast<low_t>(v));
+                    }
+                }
+                break;
+        }
+    }
+
+    /**
+     * Sets the bits of all values (words must hold BITMAP_WORDS words)
+     */
+    void fill(word_t* words) const noexcept
+    {
+        if (m_type == chunk_type::BITMAP)
+        {
+            dynamic_bitset::apply<dynamic_bitset::bit_op::OR>(words, m_words.data(), BITMAP_WORDS);
+        }
+        else if (m_type == chunk_type::RUN)
+        {
+            for (std::size_t i{0}; i < runs(); ++i)
+            {
+                const std::size_t first_ = m_values[2 * i];
+                const std::size_t last_ = run_end(i);
+                const auto first_word_ = first_ / BITS_IN_WORD;
+                const auto last_word_ = last_ / BITS_IN_WORD;
+                const auto head_ = ~word_t{0} << (first_ % BITS_IN_WORD);
+                const auto tail_ = ~word_t{0} >> (BITS_IN_WORD - 1 - last_ % BITS_IN_WORD);
+                if (first_word_ == last_word_)
+                {
+                    words[first_word_] |= head_ & tail_;
+                    continue;
+                }
+                words[first_word_] |= head_;
+                for (auto w = first_word_ + 1; w < last_word_; ++w)
+                {
+                    words[w] = ~word_t{0};
+                }
+                words[last_word_] |= tail_;
+            }
+        }
+        else
+        {
+            for (const auto value : m_values)
+            {
+                words[value / BITS_IN_WORD] |= word_t{1} << (value % BITS_IN_WORD);
+            }
+        }
+    }
+
+    void to_bitmap()
+    {
+        std::vector<word_t> words_(BITMAP_WORDS, 0);
+        fill(words_.data());
+        m_words.swap(words_);
+        std::vector<low_t>().swap(m_values);
+        m_type = chunk_type::BITMAP;
+    }
+
+    void to_array()
+    {
+        std::vector<low_t> values_;
+        values_.reserve(m_cardinality);
+        for_each([&values_](low_t value) { values_.push_back(value); });
+        m_values.swap(values_);
+        std::vector<word_t>().swap(m_words);
+        m_type = chunk_type::ARRAY;
+    }
+
+    void to_runs()
+    {
+        std::vector<low_t> runs_;
+        for_each([&runs_](low_t value)
+        {
+            if (!runs_.empty() &&
+                std::uint32_t{runs_[runs_.size() - 2]} + runs_.back() + 1 == value)
+            {
+                ++runs_.back();
+                return;
+            }
+            runs_.push_back(value);
+            runs_.push_back(0);
+        });
+        m_values.swap(runs_);
+        std::vector<word_t>().swap(m_words);
+        m_type = chunk_type::RUN;
+    }
+
+    std::size_t count_runs() const noexcept
+    {
+        std::size_t r_{0};
+        switch (m_type)
+        {
+            case chunk_type::ARRAY:
+                for (std::size_t i{0}; i < m_values.size(); ++i)
+                {
+                    r_ += !i || m_values[i] != m_values[i - 1] + 1;
+                }
+                return r_;
+            case chunk_type::BITMAP:
+            {   //? A run starts at every set bit whose lower neighbour is zero
+                word_t carry_{0};
+                for (const auto word_ : m_words)
+                {
+                    r_ += minimal_bitset::popcount_(word_ & ~((word_ << 1) | carry_));
+                    carry_ = word_ >> (BITS_IN_WORD - 1);
+                }
+                return r_;
+            }
+            default:
+                return runs();
+        }
+    }
+
+    /**
+     * Converts to array or bitmap by cardinality (runs are kept)
+     */
+    void normalize()
+    {
+        if (m_type == chunk_type::BITMAP && m_cardinality <= ARRAY_MAX)
+        {
+            to_array();
+        }
+        else if (m_type == chunk_type::ARRAY && m_cardinality > ARRAY_MAX)
+        {
+            to_bitmap();
+        }
+    }
+
+    /**
+     * Converts to the smallest container
+     */
+    void optimize()
+    {
+        const auto run_bytes_ = 2 * sizeof(low_t) * count_runs();
+        const auto plain_bytes_ = m_cardinality <= ARRAY_MAX ?
+            sizeof(low_t) * m_cardinality : sizeof(word_t) * BITMAP_WORDS;
+        if (run_bytes_ < plain_bytes_)
+        {
+            if (m_type != chunk_type::RUN)
+            {
+                to_runs();
+            }
+        }
+        else if (m_type == chunk_type::RUN)
+        {
+            m_cardinality <= ARRAY_MAX ? to_array() : to_bitmap();
+        }
+        else
+        {
+            normalize();
+        }
+    }
+
+    /**
+     * @return true if value was not present
+     */
+    bool add(low_t value)
+    {
+        if (m_type == chunk_type::RUN)
+        {
+            if (contains(value))
+            {
+                return false;
+            }
+            m_cardinality < ARRAY_MAX ? to_array() : to_bitmap();
+        }
+        if (m_type == chunk_type::ARRAY)
+        {
+            const auto it_ = std::lower_bound(m_values.begin(), m_values.end(), value);
+            if (it_ != m_values.end() && *it_ == value)
+            {
+                return false;
+            }
+            if (m_cardinality < ARRAY_MAX)
+            {
+                m_values.insert(it_, value);
+                ++m_cardinality;
+                return true;
+            }
+            to_bitmap();
+        }
+        auto& word_ = m_words[value / BITS_IN_WORD];
+        const auto mask_ = word_t{1} << (value % BITS_IN_WORD);
+        if (word_ & mask_)
+        {
+            return false;
+        }
+        word_ |= mask_;
+        ++m_cardinality;
+        return true;
+    }
+
+    /**
+     * @return true if value was present
+     */
+    bool remove(low_t value)
+    {
+        if (m_type == chunk_type::RUN)
+        {
+            if (!contains(value))
+            {
+                return false;
+            }
+            m_cardinality <= ARRAY_MAX ? to_array() : to_bitmap();
+        }
+        if (m_type == chunk_type::ARRAY)
+        {
+            const auto it_ = std::lower_bound(m_values.begin(), m_values.end(), value);
+            if (it_ == m_values.end() || *it_ != value)
+            {
+                return false;
+            }
+            m_values.erase(it_);
+            --m_cardinality;
+            return true;
+        }
+        auto& word_ = m_words[value / BITS_IN_WORD];
+        const auto mask_ = word_t{1} << (value % BITS_IN_WORD);
+        if (!(word_ & mask_))
+        {
+            return false;
+        }
+        word_ &= ~mask_;
+        if (--m_cardinality <= ARRAY_MAX / 2)
+        {
+            to_array();
+        }
+        return true;
+    }
+};
+
+/**
+ * Bitmap chunk with the values of c
+ */
+inline chunk make_bitmap(const chunk& c)
+{
+    chunk r_;
+    r_.m_type = chunk_type::BITMAP;
+    r_.m_cardinality = c.m_cardinality;
+    if (c.m_type == chunk_type::BITMAP)
+    {
+        r_.m_words = c.m_words;
+    }
+    else
+    {
+        r_.m_words.assign(BITMAP_WORDS, 0);
+        c.fill(r_.m_words.data());
+    }
+    return r_;
+}
+
+inline chunk intersect(const chunk& a, const chunk& b)
+{
+    chunk r_;
+    if (a.m_type == chunk_type::ARRAY && b.m_type == chunk_type::ARRAY)
+    {
+        r_.m_values.resize(std::min(a.m_values.size(), b.m_values.size()) + 8);
+        r_.m_cardinality = static_cast<std::uint32_t>(intersect(a.m_values.data(),
+            a.m_values.size(), b.m_values.data(), b.m_values.size(), r_.m_values.data()));
+        r_.m_values.resize(r_.m_cardinality);
+        return r_;
+    }
+    if (a.m_type == chunk_type::ARRAY || b.m_type == chunk_type::ARRAY)
+    {
+        const auto& array_ = a.m_type == chunk_type::ARRAY ? a : b;
+        const auto& other_ = a.m_type == chunk_type::ARRAY ? b : a;
+        for (const auto value : array_.m_values)
+        {
+            if (other_.contains(value))
+            {
+                r_.m_values.push_back(value);
+            }
+        }
+        r_.m_cardinality = static_cast<std::uint32_t>(r_.m_values.size());
+        return r_;
+    }
+    r_ = make_bitmap(a.m_type == chunk_type::BITMAP ? a : b);
+    const auto& other_ = a.m_type == chunk_type::BITMAP ? b : a;
+    if (other_.m_type == chunk_type::BITMAP)
+    {
+        dynamic_bitset::apply<dynamic_bitset::bit_op::AND>(
+            r_.m_words.data(), other_.m_words.data(), BITMAP_WORDS);
+    }
+    else
+    {
+        const auto mask_ = make_bitmap(other_);
+        dynamic_bitset::apply<dynamic_bitset::bit_op::AND>(
+            r_.m_words.data(), mask_.m_words.data(), BITMAP_WORDS);
+    }
+    r_.m_cardinality = static_cast<std::uint32_t>(dynamic_bitset::count<dynamic_bitset::bit_op::FIRST>(
+        r_.m_words.data(), r_.m_words.data(), BITMAP_WORDS));
+    r_.normalize();
+    return r_;
+}
+
+inline std::size_t intersect_count(const chunk& a, const chunk& b)
+{
+    if (a.m_type == chunk_type::ARRAY || b.m_type == chunk_type::ARRAY)
+    {
+        if (a.m_type == b.m_type)
+        {
+            return intersect(a, b).m_cardinality;
+        }
+        const auto& array_ = a.m_type == chunk_type::ARRAY ? a : b;
+        const auto& other_ = a.m_type == chunk_type::ARRAY ? b : a;
+        std::size_t r_{0};
+        for (const auto value : array_.m_values)
+        {
+            r_ += other_.contains(value);
+        }
+        return r_;
+    }
+    if (a.m_type == chunk_type::BITMAP && b.m_type == chunk_type::BITMAP)
+    {
+        return dynamic_bitset::count<dynamic_bitset::bit_op::AND>(
+            a.m_words.data(), b.m_words.data(), BITMAP_WORDS);
+    }
+    const auto a_ = make_bitmap(a);
+    const auto b_ = make_bitmap(b);
+    return dynamic_bitset::count<dynamic_bitset::bit_op::AND>(
+        a_.m_words.data(), b_.m_words.data(), BITMAP_WORDS);
+}
+
+inline chunk unite(const chunk& a, const chunk& b)
+{
+    if (a.m_type == chunk_type::ARRAY && b.m_type == chunk_type::ARRAY &&
+        a.m_cardinality + b.m_cardinality <= ARRAY_MAX)
+    {
+        chunk r_;
+        r_.m_values.resize(a.m_values.size() + b.m_values.size());
+        const auto end_ = std::set_union(a.m_values.begin(), a.m_values.end(),
+            b.m_values.begin(), b.m_values.end(), r_.m_values.begin());
+        r_.m_values.erase(end_, r_.m_values.end());
+        r_.m_cardinality = static_cast<std::uint32_t>(r_.m_values.size());
+        return r_;
+    }
+    //? The bitmap operand (if any) is copied, the other one is or-ed into it
+    const bool swap_ = b.m_type == chunk_type::BITMAP;
+    auto r_ = make_bitmap(swap_ ? b : a);
+    (swap_ ? a : b).fill(r_.m_words.data());
+    r_.m_cardinality = static_cast<std::uint32_t>(dynamic_bitset::count<dynamic_bitset::bit_op::FIRST>(
+        r_.m_words.data(), r_.m_words.data(), BITMAP_WORDS));
+    r_.normalize();
+    return r_;
+}
+
+constexpr std::size_t HEADER_SIZE = 8;
+constexpr std::size_t DESCRIPTOR_SIZE = 16;
+constexpr std::uint32_t MAGIC = 0x42524345; //? "ECRB" in little-endian
+
+inline std::size_t align8(std::size_t offset) noexcept
+{
+    return (offset + 7) & ~std::size_t{7};
+}
+
+} // namespace roaring
+} // namespace detail
+
+/**
+ * @brief Read-only roaring bitmap over its serialized form
+ * The data is not copied and must outlive the view.
+ */
+class roaring_view
+{
+  public:
+    using value_type    = std::uint32_t;
+    using size_type     = std::size_t;
+
+    /**
+     * @brief Chunk descriptor decoded from the serialized form
+     */
+    struct descriptor
+    {
+        std::uint16_t m_key;
+        detail::roaring::chunk_type m_type;
+        std::uint32_t m_cardinality;
+        //? Count of 16-bit units of the payload
+        std::uint32_t m_length;
+        const types::memory_t* m_payload;
+    };
+
+  private:
+    const types::memory_t* m_data;
+    size_type m_chunks;
+
+    [[noreturn]] static void malformed_()
+    {
+        throw std::invalid_argument{"roaring_view malformed data"};
+    }
+
+    inline std::uint16_t key_(size_type chunk) const noexcept
+    {
+        using namespace detail::roaring;
+        return load_le<std::uint16_t>(m_data + HEADER_SIZE + chunk * DESCRIPTOR_SIZE);
+    }
+
+    /**
+     * Count of values in the payload or 0 if the payload breaks the chunk
+     * invariants (unsorted or repeated array values, unsorted, overlapping
+     * or overflowing runs)
+     */
+    static std::uint32_t payload_cardinality_(const descriptor& d) noexcept
+    {
+        using namespace detail::roaring;
+        std::uint32_t r_{0};
+        if (d.m_type == chunk_type::BITMAP)
+        {
+            for (size_type w{0}; w < BITMAP_WORDS; ++w)
+            {
+                r_ += static_cast<std::uint32_t>(
+                    detail::minimal_bitset::popcount_(load_le<word_t>(d.m_payload + w * sizeof(word_t))));
+            }
+            return r_;
+        }
+        if (d.m_type == chunk_type::ARRAY)
+        {
+            for (size_type v{1}; v < d.m_length; ++v)
+            {
+                if (load_le<low_t>(d.m_payload + (v - 1) * sizeof(low_t)) >=
+                        load_le<low_t>(d.m_payload + v * sizeof(low_t)))
+                {
+                    return 0;
+                }
+            }
+            return static_cast<std::uint32_t>(d.m_length);
+        }
+        //? RUN: the next run starts after the end of the previous one
+        std::uint32_t next_{0};
+        for (size_type i{0}; i < d.m_length; i += 2)
+        {
+            const std::uint32_t start_ = load_le<low_t>(d.m_payload + i * sizeof(low_t));
+            const std::uint32_t end_ = start_ + load_le<low_t>(d.m_payload + (i + 1) * sizeof(low_t));
+            if (start_ < next_ || end_ >= CHUNK_VALUES)
+            {
+                return 0;
+            }
+            r_ += end_ - start_ + 1;
+            next_ = end_ + 1;
+        }
+        return r_;
+    }
+
+  public:
+    /**
+     * @brief Checks the layout of data
+     * @throw std::invalid_argument if data is not a serialized roaring bitmap
+     */
+    roaring_view(const void* data, size_type size) :
+        m_data{static_cast<const types::memory_t*>(data)}, m_chunks{0}
+    {
+        using namespace detail::roaring;
+        if (size < HEADER_SIZE || load_le<std::uint32_t>(m_data) != MAGIC)
+        {
+            malformed_();
+        }
+        m_chunks = load_le<std::uint32_t>(m_data + 4);
+        if (m_chunks > (size - HEADER_SIZE) / DESCRIPTOR_SIZE)
+        {
+            malformed_();
+        }
+        for (size_type i{0}; i < m_chunks; ++i)
+        {
+            //? The offset is checked before the payload pointer is formed
+            const size_type offset_ =
+                load_le<std::uint32_t>(m_data + HEADER_SIZE + i * DESCRIPTOR_SIZE + 12);
+            if (offset_ > size)
+            {
+                malformed_();
+            }
+            const auto d_ = at(i);
+            const bool valid_ =
+                (i == 0 || key_(i - 1) < d_.m_key) &&
+                d_.m_cardinality && d_.m_cardinality <= CHUNK_VALUES &&
+                d_.m_length <= (size - offset_) / sizeof(low_t) &&
+                (d_.m_type == chunk_type::ARRAY ? d_.m_length == d_.m_cardinality &&
+                    d_.m_cardinality <= ARRAY_MAX :
+                 d_.m_type == chunk_type::BITMAP ?
+                    d_.m_length == BITMAP_WORDS * sizeof(word_t) / sizeof(low_t) :
+                 d_.m_type == chunk_type::RUN ? d_.m_length && d_.m_length % 2 == 0 : false);
+            if (!valid_ || payload_cardinality_(d_) != d_.m_cardinality)
+            {
+                malformed_();
+            }
+        }
+    }
+
+    /**
+     * @brief Count of chunks (distinct high 16 bits)
+     */
+    inline size_type chunk_count() const noexcept { return m_chunks; }
+
+    /**
+     * @brief Descriptor of the chunk (chunk must be less than chunk_count())
+     */
+    descriptor at(size_type chunk) const noexcept
+    {
+        using namespace detail::roaring;
+        const auto* d_ = m_data + HEADER_SIZE + chunk * DESCRIPTOR_SIZE;
+        return descriptor{
+            load_le<std::uint16_t>(d_),
+            static_cast<chunk_type>(load_le<std::uint16_t>(d_ + 2)),
+            load_le<std::uint32_t>(d_ + 4),
+            load_le<std::uint32_t>(d_ + 8),
+            m_data + load_le<std::uint32_t>(d_ + 12)};
+    }
+
+    /**
+     * @brief Count of values
+     */
+    size_type size() const noexcept
+    {
+        size_type r_{0};
+        for (size_type i{0}; i < m_chunks; ++i)
+        {
+            r_ += at(i).m_cardinality;
+        }
+        return r_;
+    }
+
+    inline bool empty() const noexcept { return m_chunks == 0; }
+
+    bool contains(value_type value) const noexcept
+    {
+        using namespace detail::roaring;
+        const auto key_value_ = static_cast<std::uint16_t>(value >> 16);
+        const auto low_ = static_cast<low_t>(value);
+        size_type lo_{0}, hi_{m_chunks};
+        while (lo_ < hi_)
+        {
+            const auto mid_ = (lo_ + hi_) / 2;
+            if (key_(mid_) < key_value_)
+            {
+                lo_ = mid_ + 1;
+            }
+            else
+            {
+                hi_ = mid_;
+            }
+        }
+        if (lo_ == m_chunks || key_(lo_) != key_value_)
+        {
+            return false;
+        }
+        const auto d_ = at(lo_);
+        if (d_.m_type == chunk_type::BITMAP)
+        {
+            return (load_le<word_t>(d_.m_payload + low_ / BITS_IN_WORD * sizeof(word_t)) >>
+                (low_ % BITS_IN_WORD)) & 1;
+        }
+        //? Array values or run starts: the last one not greater than low_
+        const size_type stride_ = d_.m_type == chunk_type::RUN ? 2 : 1;
+        lo_ = 0;
+        hi_ = d_.m_length / stride_;
+        while (lo_ < hi_)
+        {
+            const auto mid_ = (lo_ + hi_) / 2;
+            if (load_le<low_t>(d_.m_payload + mid_ * stride_ * sizeof(low_t)) <= low_)
+            {
+                lo_ = mid_ + 1;
+            }
+            else
+            {
+                hi_ = mid_;
+            }
+        }
+        if (!lo_)
+        {
+            return false;
+        }
+        const auto* found_ = d_.m_payload + (lo_ - 1) * stride_ * sizeof(low_t);
+        const std::uint32_t start_ = load_le<low_t>(found_);
+        return stride_ == 1 ? start_ == low_ :
+            low_ <= start_ + load_le<low_t>(found_ + sizeof(low_t));
+    }
+};
+
+/**
+ * @brief Compressed set of 32-bit unsigned values
+ */
+class roaring_bitmap
+{
+    using chunk_t       = detail::roaring::chunk;
+    using chunk_type    = detail::roaring::chunk_type;
+    using low_t         = detail::roaring::low_t;
+
+  public:
+    using value_type    = std::uint32_t;
+    using size_type     = std::size_t;
+
+    class const_iterator
+    {
+        friend class roaring_bitmap;
+
+      public:
+        using value_type        = std::uint32_t;
+        using pointer           = const value_type*;
+        using reference         = value_type;
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+
+      private:
+        const roaring_bitmap* m_container;
+        size_type m_chunk;
+        //? Array index or run index (unused for bitmaps)
+        size_type m_index;
+        //? Low 16 bits of the current value
+        std::uint32_t m_low;
+
+        const_iterator(const roaring_bitmap* container, size_type chunk) noexcept :
+            m_container{container}, m_chunk{chunk}, m_index{0}, m_low{0}
+        {
+            seek_chunk_();
+        }
+
+        /**
+         * First set bit of the bitmap chunk at or after position or CHUNK_VALUES
+         */
+        static std::uint32_t find_bit_(const chunk_t& c, std::uint32_t position) noexcept
+        {
+            using namespace detail::roaring;
+            auto w_ = position / BITS_IN_WORD;
+            auto bits_ = c.m_words[w_] & (~word_t{0} << (position % BITS_IN_WORD));
+            while (!bits_)
+            {
+                if (++w_ == BITMAP_WORDS)
+                {
+                    return CHUNK_VALUES;
+                }
+                bits_ = c.m_words[w_];
+            }
+            return static_cast<std::uint32_t>(
+                w_ * BITS_IN_WORD + detail::minimal_bitset::lowest_bit_(bits_));
+        }
+
+        //? Chunks are never empty, so the first value of m_chunk always exists
+        void seek_chunk_() noexcept
+        {
+            m_index = 0;
+            if (m_chunk == m_container->m_chunks.size())
+            {
+                m_low = 0;
+                return;
+            }
+            const auto& c_ = m_container->m_chunks[m_chunk];
+            m_low = c_.m_type == chunk_type::BITMAP ? find_bit_(c_, 0) : c_.m_values[0];
+        }
+
+      public:
+        const_iterator() noexcept : m_container{nullptr}, m_chunk{0}, m_index{0}, m_low{0} {}
+
+        reference operator*() const noexcept
+        {
+            return static_cast<value_type>(m_container->m_keys[m_chunk]) << 16 | m_low;
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            const auto& c_ = m_container->m_chunks[m_chunk];
+            bool next_{false};
+            switch (c_.m_type)
+            {
+                case chunk_type::ARRAY:
+                    if (++m_index < c_.m_values.size())
+                    {
+                        m_low = c_.m_values[m_index];
+                        next_ = true;
+                    }
+                    break;
+                case chunk_type::BITMAP:
+                    if (m_low + 1 < detail::roaring::CHUNK_VALUES)
+                    {
+                        m_low = find_bit_(c_, m_low + 1);
+                        next_ = m_low < detail::roaring::CHUNK_VALUES;
+                    }
+                    break;
+                default:
+                    if (m_low < c_.run_end(m_index))
+                    {
+                        ++m_low;
+                        next_ = true;
+                    }
+                    else if (++m_index < c_.runs())
+                    {
+                        m_low = c_.m_values[2 * m_index];
+                        next_ = true;
+                    }
+                    break;
+            }
+            if (!next_)
+            {
+                ++m_chunk;
+                seek_chunk_();
+            }
+            return *this;
+        }
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator old{*this};
+            ++(*this);
+            return old;
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {   //? This operation must not be defined for different containers
+            return lhs.m_chunk == rhs.m_chunk && lhs.m_index == rhs.m_index &&
+                lhs.m_low == rhs.m_low;
+        }
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    using iterator = const_iterator;
+
+  private:
+    //? Sorted high 16 bits of the values, one per chunk
+    std::vector<std::uint16_t> m_keys;
+    std::vector<chunk_t> m_chunks;
+
+    static constexpr std::uint16_t key_(value_type value) noexcept
+    {
+        return static_cast<std::uint16_t>(value >> 16);
+    }
+
+    static constexpr low_t low_(value_type value) noexcept
+    {
+        return static_cast<low_t>(value);
+    }
+
+    inline size_type find_key_(std::uint16_t key) const noexcept
+    {
+        return static_cast<size_type>(
+            std::lower_bound(m_keys.begin(), m_keys.end(), key) - m_keys.begin());
+    }
+
+    void erase_chunk_(size_type chunk)
+    {
+        m_keys.erase(m_keys.begin() + static_cast<std::ptrdiff_t>(chunk));
+        m_chunks.erase(m_chunks.begin() + static_cast<std::ptrdiff_t>(chunk));
+    }
+
+  public:
+    roaring_bitmap() = default;
+
+    roaring_bitmap(std::initializer_list<value_type> values)
+    {
+        for (const auto value : values)
+        {
+            add(value);
+        }
+    }
+
+    template<class InputIt>
+    roaring_bitmap(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            add(*first);
+        }
+    }
+
+    /**
+     * @brief Copies the serialized bitmap
+     */
+    explicit roaring_bitmap(const roaring_view& view)
+    {
+        using namespace detail::roaring;
+        m_keys.reserve(view.chunk_count());
+        m_chunks.resize(view.chunk_count());
+        for (size_type i{0}; i < view.chunk_count(); ++i)
+        {
+            const auto d_ = view.at(i);
+            auto& c_ = m_chunks[i];
+            m_keys.push_back(d_.m_key);
+            c_.m_type = d_.m_type;
+            c_.m_cardinality = d_.m_cardinality;
+            if (d_.m_type == chunk_type::BITMAP)
+            {
+                c_.m_words.resize(BITMAP_WORDS);
+                for (size_type w{0}; w < BITMAP_WORDS; ++w)
+                {
+                    c_.m_words[w] = load_le<word_t>(d_.m_payload + w * sizeof(word_t));
+                }
+                continue;
+            }
+            c_.m_values.resize(d_.m_length);
+            for (size_type v{0}; v < d_.m_length; ++v)
+            {
+                c_.m_values[v] = load_le<low_t>(d_.m_payload + v * sizeof(low_t));
+            }
+        }
+    }
+
+    inline const_iterator begin() const noexcept { return const_iterator{this, 0}; }
+    inline const_iterator end() const noexcept { return const_iterator{this, m_chunks.size()}; }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline const_iterator cend() const noexcept { return end(); }
+
+    /**
+     * @brief Count of values
+     */
+    size_type size() const noexcept
+    {
+        size_type r_{0};
+        for (const auto& c_ : m_chunks)
+        {
+            r_ += c_.m_cardinality;
+        }
+        return r_;
+    }
+
+    inline bool empty() const noexcept { return m_chunks.empty(); }
+
+    /**
+     * @brief Count of chunks (distinct high 16 bits)
+     */
+    inline size_type chunk_count() const noexcept { return m_chunks.size(); }
+
+    void clear() noexcept
+    {
+        m_keys.clear();
+        m_chunks.clear();
+    }
+
+    bool contains(value_type value) const noexcept
+    {
+        const auto chunk_ = find_key_(key_(value));
+        return chunk_ != m_keys.size() && m_keys[chunk_] == key_(value) &&
+            m_chunks[chunk_].contains(low_(value));
+    }
+
+    /**
+     * @return true if value was not present
+     */
+    bool add(value_type value)
+    {
+        const auto chunk_ = find_key_(key_(value));
+        if (chunk_ == m_keys.size() || m_keys[chunk_] != key_(value))
+        {
+            m_keys.insert(m_keys.begin() + static_cast<std::ptrdiff_t>(chunk_), key_(value));
+            m_chunks.insert(m_chunks.begin() + static_cast<std::ptrdiff_t>(chunk_), chunk_t{});
+        }
+        return m_chunks[chunk_].add(low_(value));
+    }
+
+    /**
+     * @return true if value was present
+     */
+    bool remove(value_type value)
+    {
+        const auto chunk_ = find_key_(key_(value));
+        if (chunk_ == m_keys.size() || m_keys[chunk_] != key_(value) ||
+            !m_chunks[chunk_].remove(low_(value)))
+        {
+            return false;
+        }
+        if (!m_chunks[chunk_].m_cardinality)
+        {
+            erase_chunk_(chunk_);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Converts every chunk to its smallest container (array, bitmap or runs)
+     */
+    void optimize()
+    {
+        for (auto& c_ : m_chunks)
+        {
+            c_.optimize();
+        }
+    }
+
+    /* Set operations */
+
+    roaring_bitmap& operator|=(const roaring_bitmap& other)
+    {
+        *this = *this | other;
+        return *this;
+    }
+
+    roaring_bitmap& operator&=(const roaring_bitmap& other)
+    {
+        *this = *this & other;
+        return *this;
+    }
+
+    friend roaring_bitmap operator|(const roaring_bitmap& lhs, const roaring_bitmap& rhs)
+    {
+        roaring_bitmap r_;
+        r_.m_keys.reserve(lhs.m_keys.size() + rhs.m_keys.size());
+        r_.m_chunks.reserve(lhs.m_keys.size() + rhs.m_keys.size());
+        size_type i_{0}, j_{0};
+        while (i_ < lhs.m_keys.size() || j_ < rhs.m_keys.size())
+        {
+            if (j_ == rhs.m_keys.size() ||
+                (i_ < lhs.m_keys.size() && lhs.m_keys[i_] < rhs.m_keys[j_]))
+            {
+                r_.m_keys.push_back(lhs.m_keys[i_]);
+                r_.m_chunks.push_back(lhs.m_chunks[i_++]);
+            }
+            else if (i_ == lhs.m_keys.size() || rhs.m_keys[j_] < lhs.m_keys[i_])
+            {
+                r_.m_keys.push_back(rhs.m_keys[j_]);
+                r_.m_chunks.push_back(rhs.m_chunks[j_++]);
+            }
+            else
+            {
+                r_.m_keys.push_back(lhs.m_keys[i_]);
+                r_.m_chunks.push_back(detail::roaring::unite(lhs.m_chunks[i_++], rhs.m_chunks[j_++]));
+            }
+        }
+        return r_;
+    }
+
+    friend roaring_bitmap operator&(const roaring_bitmap& lhs, const roaring_bitmap& rhs)
+    {
+        roaring_bitmap r_;
+        size_type i_{0}, j_{0};
+        while (i_ < lhs.m_keys.size() && j_ < rhs.m_keys.size())
+        {
+            if (lhs.m_keys[i_] < rhs.m_keys[j_])
+            {
+                ++i_;
+            }
+            else if (rhs.m_keys[j_] < lhs.m_keys[i_])
+            {
+                ++j_;
+            }
+            else
+            {
+                auto chunk_ = detail::roaring::intersect(lhs.m_chunks[i_], rhs.m_chunks[j_]);
+                if (chunk_.m_cardinality)
+                {
+                    r_.m_keys.push_back(lhs.m_keys[i_]);
+                    r_.m_chunks.push_back(std::move(chunk_));
+                }
+                ++i_;
+                ++j_;
+            }
+        }
+        return r_;
+    }
+
+    /**
+     * @brief Cardinality of lhs & rhs without building it
+     */
+    friend size_type intersection_size(const roaring_bitmap& lhs, const roaring_bitmap& rhs)
+    {
+        size_type r_{0};
+        size_type i_{0}, j_{0};
+        while (i_ < lhs.m_keys.size() && j_ < rhs.m_keys.size())
+        {
+            if (lhs.m_keys[i_] < rhs.m_keys[j_])
+            {
+                ++i_;
+            }
+            else if (rhs.m_keys[j_] < lhs.m_keys[i_])
+            {
+                ++j_;
+            }
+            else
+            {
+                r_ += detail::roaring::intersect_count(lhs.m_chunks[i_++], rhs.m_chunks[j_++]);
+            }
+        }
+        return r_;
+    }
+
+    friend bool operator==(const roaring_bitmap& lhs, const roaring_bitmap& rhs)
+    {
+        if (lhs.m_keys != rhs.m_keys)
+        {
+            return false;
+        }
+        for (size_type i{0}; i < lhs.m_chunks.size(); ++i)
+        {
+            const auto& a_ = lhs.m_chunks[i];
+            const auto& b_ = rhs.m_chunks[i];
+            if (a_.m_cardinality != b_.m_cardinality ||
+                detail::roaring::intersect_count(a_, b_) != a_.m_cardinality)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const roaring_bitmap& lhs, const roaring_bitmap& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    /* Serialization */
+
+    /**
+     * @brief Size of the serialized form in bytes
+     */
+    size_type serialized_size() const noexcept
+    {
+        using namespace detail::roaring;
+        auto r_ = HEADER_SIZE + m_chunks.size() * DESCRIPTOR_SIZE;
+        for (const auto& c_ : m_chunks)
+        {
+            r_ = c_.m_type == chunk_type::BITMAP ?
+                align8(r_) + BITMAP_WORDS * sizeof(word_t) :
+                r_ + c_.m_values.size() * sizeof(low_t);
+        }
+        return r_;
+    }
+
+    /**
+     * @brief Writes serialized_size() bytes to dst (see roaring_view)
+     * @return Count of bytes written
+     */
+    size_type serialize(types::memory_t* dst) const noexcept
+    {
+        using namespace detail::roaring;
+        store_le<std::uint32_t>(dst, MAGIC);
+        store_le<std::uint32_t>(dst + 4, static_cast<std::uint32_t>(m_chunks.size()));
+        auto offset_ = HEADER_SIZE + m_chunks.size() * DESCRIPTOR_SIZE;
+        for (size_type i{0}; i < m_chunks.size(); ++i)
+        {
+            const auto& c_ = m_chunks[i];
+            const bool bitmap_ = c_.m_type == chunk_type::BITMAP;
+            if (bitmap_)
+            {
+                const auto aligned_ = align8(offset_);
+                std::fill(dst + offset_, dst + aligned_, types::memory_t{0});
+                offset_ = aligned_;
+            }
+            auto* d_ = dst + HEADER_SIZE + i * DESCRIPTOR_SIZE;
+            store_le<std::uint16_t>(d_, m_keys[i]);
+            store_le<std::uint16_t>(d_ + 2, static_cast<std::uint16_t>(c_.m_type));
+            store_le<std::uint32_t>(d_ + 4, c_.m_cardinality);
+            store_le<std::uint32_t>(d_ + 8, static_cast<std::uint32_t>(bitmap_ ?
+                BITMAP_WORDS * sizeof(word_t) / sizeof(low_t) : c_.m_values.size()));
+            store_le<std::uint32_t>(d_ + 12, static_cast<std::uint32_t>(offset_));
+            if (bitmap_)
+            {
+                for (const auto word_ : c_.m_words)
+                {
+                    store_le<word_t>(dst + offset_, word_);
+                    offset_ += sizeof(word_t);
+                }
+                continue;
+            }
+            for (const auto value_ : c_.m_values)
+            {
+                store_le<low_t>(dst + offset_, value_);
+                offset_ += sizeof(low_t);
+            }
+        }
+        return offset_;
+    }
+};
+
+} // namespace containers
+
+using roaring_bitmap_t = containers::roaring_bitmap;
+using roaring_view_t = containers::roaring_view;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_ROARING_BITMAP_HPP_ */
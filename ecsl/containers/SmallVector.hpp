@@ -0,0 +1,614 @@
+#ifndef ECSL_CONTAINERS_SMALL_VECTOR_HPP_
+#define ECSL_CONTAINERS_SMALL_VECTOR_HPP_
+
+/**
+ * @file SmallVector.hpp
+ * Declares vector that keeps up to N elements inline and spills to the heap
+ *
+ * Layout: one size_type header and a union of the inline buffer with the
+ * heap pointer, so the object takes max(N * sizeof(T), sizeof(T*)) + 8
+ * bytes (rounded to alignof(T)). The header holds the size in its high
+ * bits and log2 of heap capacity in the low 6 bits (0 while inline): heap
+ * capacities are powers of two greater than N.
+ * Trivially relocatable elements are moved between buffers with memcpy,
+ * others are move (or copy if move may throw) constructed and destroyed.
+ *
+ * Sources:
+ *  LLVM SmallVector, folly::small_vector
+ *  P1144 "Object relocation in terms of move plus destroy"
+ */
+
+/// STD
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+/// ECSL
+#include <ecsl/containers/detail/ValueTrait.hpp>
+#include <ecsl/utility/Launder.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace small_vector {
+
+constexpr std::size_t CAPACITY_BITS = 6;
+constexpr std::size_t CAPACITY_MASK = (std::size_t{1} << CAPACITY_BITS) - 1;
+
+/**
+ * log2 of the least power of two not less than value, value > 1
+ */
+inline std::size_t ceil_log2(std::size_t value) noexcept
+{
+    std::size_t r_{0};
+    for (--value; value; value >>= 1)
+    {
+        ++r_;
+    }
+    return r_;
+}
+
+} // namespace small_vector
+} // namespace detail
+
+/**
+ * @brief Contiguous sequence container with inline storage for N elements
+ * Iterators are pointers, they are invalidated by any reallocation and by
+ * moving the inline content of the vector.
+ */
+template<class T, std::size_t N>
+class small_vector
+{
+    static_assert(N > 0, "small_vector requires inline capacity N > 0");
+
+    using vt_t = detail::value_trait<T>;
+
+  public:
+    using value_type                = typename vt_t::value_type;
+    using reference                 = typename vt_t::reference;
+    using const_reference           = typename vt_t::const_reference;
+    using pointer                   = typename vt_t::pointer;
+    using const_pointer             = typename vt_t::const_pointer;
+    using size_type                 = typename vt_t::size_type;
+    using difference_type           = std::ptrdiff_t;
+    using iterator                  = pointer;
+    using const_iterator            = const_pointer;
+    using reverse_iterator          = std::reverse_iterator<iterator>;
+    using const_reverse_iterator    = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type INLINE_CAPACITY = N;
+
+  private:
+    static constexpr bool RELOCATABLE = is_trivially_relocatable<value_type>::value;
+
+    size_type m_header;
+    union
+    {
+        pointer m_heap;
+        alignas(value_type) unsigned char m_inline[N * sizeof(value_type)];
+    };
+
+    inline bool heap_() const noexcept
+    {
+        return m_header & detail::small_vector::CAPACITY_MASK;
+    }
+
+    inline pointer inline_data_() noexcept
+    {
+        return launder<pointer>(m_inline);
+    }
+
+    inline const_pointer inline_data_() const noexcept
+    {
+        return launder<const_pointer>(m_inline);
+    }
+
+    inline void set_size_(size_type count) noexcept
+    {
+        m_header = (count << detail::small_vector::CAPACITY_BITS) |
+            (m_header & detail::small_vector::CAPACITY_MASK);
+    }
+
+    static pointer allocate_(size_type count)
+    {
+        return std::allocator<value_type>{}.allocate(count);
+    }
+
+    static void deallocate_(pointer p, size_type count) noexcept
+    {
+        std::allocator<value_type>{}.deallocate(p, count);
+    }
+
+    static void destroy_(pointer first, pointer last) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<value_type>::value)
+        {
+            for (; first != last; ++first)
+            {
+                first->~value_type();
+            }
+        }
+    }
+
+    /**
+     * Moves count elements to uninitialized dst, the source is left destroyed
+     */
+    static void relocate_(pointer src, size_type count, pointer dst)
+        noexcept(RELOCATABLE || std::is_nothrow_move_constructible<value_type>::value)
+    {
+        if constexpr (RELOCATABLE)
+        {
+            if (count)
+            {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                    count * sizeof(value_type));
+            }
+        }
+        else
+        {
+            if constexpr (std::is_nothrow_move_constructible<value_type>::value ||
+                !std::is_copy_constructible<value_type>::value)
+            {
+                std::uninitialized_move(src, src + count, dst);
+            }
+            else
+            {   //? Strong guarantee: the source is intact if a copy throws
+                std::uninitialized_copy(src, src + count, dst);
+            }
+            destroy_(src, src + count);
+        }
+    }
+
+    /**
+     * Frees the heap buffer (elements must be destroyed or relocated)
+     */
+    void release_() noexcept
+    {
+        if (heap_())
+        {
+            deallocate_(m_heap, capacity());
+        }
+        m_header = 0;
+    }
+
+    /**
+     * Moves the elements to the heap buffer of 2^log2 capacity
+     */
+    void reallocate_(size_type log2)
+    {
+        const auto size_ = size();
+        auto* data_ = allocate_(size_type{1} << log2);
+        try
+        {
+            relocate_(data(), size_, data_);
+        }
+        catch (...)
+        {
+            deallocate_(data_, size_type{1} << log2);
+            throw;
+        }
+        release_();
+        m_heap = data_;
+        m_header = (size_ << detail::small_vector::CAPACITY_BITS) | log2;
+    }
+
+    /**
+     * Appends an element when the vector is full
+     */
+    template<class ... Args>
+    reference grow_emplace_(Args&& ... args)
+    {
+        const auto size_ = size();
+        const auto log2_ = detail::small_vector::ceil_log2(std::max(size_ + 1, N + 1));
+        auto* data_ = allocate_(size_type{1} << log2_);
+        //? The new element is constructed first: args may refer to elements
+        try
+        {
+            ::new(static_cast<void*>(data_ + size_)) value_type(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate_(data_, size_type{1} << log2_);
+            throw;
+        }
+        try
+        {
+            relocate_(data(), size_, data_);
+        }
+        catch (...)
+        {
+            data_[size_].~value_type();
+            deallocate_(data_, size_type{1} << log2_);
+            throw;
+        }
+        release_();
+        m_heap = data_;
+        m_header = ((size_ + 1) << detail::small_vector::CAPACITY_BITS) | log2_;
+        return data_[size_];
+    }
+
+    /**
+     * Takes the content of other, other is left empty
+     */
+    void steal_(small_vector& other)
+        noexcept(RELOCATABLE || std::is_nothrow_move_constructible<value_type>::value)
+    {
+        if (other.heap_())
+        {
+            m_heap = other.m_heap;
+            m_header = other.m_header;
+        }
+        else
+        {
+            relocate_(other.inline_data_(), other.size(), inline_data_());
+            m_header = other.m_header;
+        }
+        other.m_header = 0;
+    }
+
+  public:
+    small_vector() noexcept : m_header{0} {}
+
+    explicit small_vector(size_type count) : small_vector()
+    {
+        resize(count);
+    }
+
+    small_vector(size_type count, const value_type& value) : small_vector()
+    {
+        resize(count, value);
+    }
+
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    small_vector(InputIt first, InputIt last) : small_vector()
+    {
+        assign(first, last);
+    }
+
+    small_vector(std::initializer_list<value_type> init) : small_vector()
+    {
+        assign(init.begin(), init.end());
+    }
+
+    small_vector(const small_vector& other) : small_vector()
+    {
+        assign(other.begin(), other.end());
+    }
+
+    small_vector(small_vector&& other)
+        noexcept(RELOCATABLE || std::is_nothrow_move_constructible<value_type>::value) :
+        small_vector()
+    {
+        steal_(other);
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if (this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other)
+        noexcept(RELOCATABLE || std::is_nothrow_move_constructible<value_type>::value)
+    {
+        if (this != &other)
+        {
+            clear();
+            release_();
+            steal_(other);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<value_type> init)
+    {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~small_vector()
+    {
+        clear();
+        release_();
+    }
+
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    void assign(InputIt first, InputIt last)
+    {
+        clear();
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+            typename std::iterator_traits<InputIt>::iterator_category>::value)
+        {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    void assign(size_type count, const value_type& value)
+    {
+        clear();
+        resize(count, value);
+    }
+
+    /* Capacity */
+
+    inline size_type size() const noexcept
+    {
+        return m_header >> detail::small_vector::CAPACITY_BITS;
+    }
+
+    inline bool empty() const noexcept { return size() == 0; }
+
+    inline size_type capacity() const noexcept
+    {
+        return heap_() ? size_type{1} << (m_header & detail::small_vector::CAPACITY_MASK) : N;
+    }
+
+    static constexpr size_type max_size() noexcept
+    {
+        return ~size_type{0} >> detail::small_vector::CAPACITY_BITS;
+    }
+
+    /**
+     * @brief Whether the elements are stored inline
+     */
+    inline bool is_inline() const noexcept { return !heap_(); }
+
+    /**
+     * @brief Reserves storage for at least count elements
+     * Heap capacity is rounded up to a power of two.
+     */
+    void reserve(size_type count)
+    {
+        if (count > capacity())
+        {
+            if (count > max_size())
+            {
+                throw std::length_error{"small_vector length error"};
+            }
+            reallocate_(detail::small_vector::ceil_log2(count));
+        }
+    }
+
+    /**
+     * @brief Moves the elements inline if they fit or to the least heap buffer
+     */
+    void shrink_to_fit()
+    {
+        if (!heap_())
+        {
+            return;
+        }
+        const auto size_ = size();
+        if (size_ <= N)
+        {
+            auto* heap_data_ = m_heap;
+            const auto capacity_ = capacity();
+            relocate_(heap_data_, size_, inline_data_());
+            deallocate_(heap_data_, capacity_);
+            m_header = size_ << detail::small_vector::CAPACITY_BITS;
+        }
+        else if (const auto log2_ = detail::small_vector::ceil_log2(size_);
+                 (size_type{1} << log2_) < capacity())
+        {
+            reallocate_(log2_);
+        }
+    }
+
+    /* Element access */
+
+    inline pointer data() noexcept { return heap_() ? m_heap : inline_data_(); }
+    inline const_pointer data() const noexcept { return heap_() ? m_heap : inline_data_(); }
+
+    inline reference operator[](size_type position) noexcept { return data()[position]; }
+    inline const_reference operator[](size_type position) const noexcept { return data()[position]; }
+
+    reference at(size_type position)
+    {
+        if (position < size())
+        {
+            return data()[position];
+        }
+        throw std::out_of_range{"small_vector range check failed"};
+    }
+
+    const_reference at(size_type position) const
+    {
+        if (position < size())
+        {
+            return data()[position];
+        }
+        throw std::out_of_range{"small_vector range check failed"};
+    }
+
+    inline reference front() noexcept { return data()[0]; }
+    inline const_reference front() const noexcept { return data()[0]; }
+    inline reference back() noexcept { return data()[size() - 1]; }
+    inline const_reference back() const noexcept { return data()[size() - 1]; }
+
+    /* Iterators */
+
+    inline iterator begin() noexcept { return data(); }
+    inline const_iterator begin() const noexcept { return data(); }
+    inline const_iterator cbegin() const noexcept { return data(); }
+    inline iterator end() noexcept { return data() + size(); }
+    inline const_iterator end() const noexcept { return data() + size(); }
+    inline const_iterator cend() const noexcept { return data() + size(); }
+
+    inline reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+    inline const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{end()}; }
+    inline reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+    inline const_reverse_iterator rend() const noexcept { return const_reverse_iterator{begin()}; }
+
+    /* Modifiers */
+
+    template<class ... Args>
+    reference emplace_back(Args&& ... args)
+    {
+        const auto size_ = size();
+        if (size_ == capacity())
+        {
+            return grow_emplace_(std::forward<Args>(args)...);
+        }
+        auto* p_ = ::new(static_cast<void*>(data() + size_)) value_type(std::forward<Args>(args)...);
+        m_header += size_type{1} << detail::small_vector::CAPACITY_BITS;
+        return *p_;
+    }
+
+    inline void push_back(const value_type& value) { emplace_back(value); }
+    inline void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+    inline void pop_back() noexcept
+    {
+        data()[size() - 1].~value_type();
+        m_header -= size_type{1} << detail::small_vector::CAPACITY_BITS;
+    }
+
+    template<class ... Args>
+    iterator emplace(const_iterator position, Args&& ... args)
+    {
+        const auto index_ = static_cast<size_type>(position - begin());
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + index_, end() - 1, end());
+        return begin() + index_;
+    }
+
+    inline iterator insert(const_iterator position, const value_type& value)
+    {
+        return emplace(position, value);
+    }
+
+    inline iterator insert(const_iterator position, value_type&& value)
+    {
+        return emplace(position, std::move(value));
+    }
+
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    iterator insert(const_iterator position, InputIt first, InputIt last)
+    {
+        const auto index_ = static_cast<size_type>(position - begin());
+        const auto size_ = size();
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+        std::rotate(begin() + index_, begin() + size_, end());
+        return begin() + index_;
+    }
+
+    iterator insert(const_iterator position, std::initializer_list<value_type> init)
+    {
+        return insert(position, init.begin(), init.end());
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        auto* first_ = begin() + (first - begin());
+        if (first != last)
+        {
+            auto* end_ = std::move(first_ + (last - first), end(), first_);
+            destroy_(end_, end());
+            set_size_(static_cast<size_type>(end_ - begin()));
+        }
+        return first_;
+    }
+
+    inline iterator erase(const_iterator position)
+    {
+        return erase(position, position + 1);
+    }
+
+    void resize(size_type count)
+    {
+        if (count < size())
+        {
+            destroy_(data() + count, end());
+            return set_size_(count);
+        }
+        reserve(count);
+        for (auto size_ = size(); size_ < count; ++size_)
+        {
+            ::new(static_cast<void*>(data() + size_)) value_type();
+            set_size_(size_ + 1);
+        }
+    }
+
+    void resize(size_type count, const value_type& value)
+    {
+        if (count < size())
+        {
+            destroy_(data() + count, end());
+            return set_size_(count);
+        }
+        if (count > capacity())
+        {   //? value may refer to an element
+            const value_type copy_{value};
+            reserve(count);
+            return resize(count, copy_);
+        }
+        for (auto size_ = size(); size_ < count; ++size_)
+        {
+            ::new(static_cast<void*>(data() + size_)) value_type(value);
+            set_size_(size_ + 1);
+        }
+    }
+
+    /**
+     * @brief Destroys the elements, the storage is kept
+     */
+    inline void clear() noexcept
+    {
+        destroy_(begin(), end());
+        set_size_(0);
+    }
+
+    void swap(small_vector& other)
+        noexcept(RELOCATABLE || std::is_nothrow_move_constructible<value_type>::value)
+    {
+        if (this != &other)
+        {
+            small_vector tmp_{std::move(other)};
+            other.steal_(*this);
+            steal_(tmp_);
+        }
+    }
+
+    friend void swap(small_vector& lhs, small_vector& rhs) noexcept(noexcept(lhs.swap(rhs)))
+    {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!=(const small_vector& lhs, const small_vector& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const small_vector& lhs, const small_vector& rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+};
+
+} // namespace containers
+
+template<class T, std::size_t N>
+using small_vector_t = containers::small_vector<T, N>;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_SMALL_VECTOR_HPP_ */
@@ -0,0 +1,369 @@
+#ifndef ECSL_CONTAINERS_SPSC_RING_HPP_
+#define ECSL_CONTAINERS_SPSC_RING_HPP_
+
+/**
+ * @file SpscRing.hpp
+ * Declares bounded lock-free single producer single consumer ring buffer
+ *
+ * The producer owns the tail index and the consumer owns the head index,
+ * each on its own cache line together with a private copy of the other
+ * side's index. The shared index is reloaded only when the cached one says
+ * the ring is full (empty), so in steady state an operation touches no
+ * cache line written by the other thread except the slots themselves.
+ * Indices grow monotonically (64-bit, no wrap in practice) and are masked
+ * by capacity - 1, a power of two.
+ *
+ * Batches: push_n/pop_n publish many elements with one index store, and
+ * reserve/commit (peek/consume) give direct access to contiguous slots:
+ *  auto slots = ring.reserve(64);
+ *  for (auto& slot : slots) { ::new(&slot) T{...}; } //? plain writes for trivial T
+ *  ring.commit(slots.size());
+ *
+ * Sources:
+ *  E. Rigtorp "Optimizing a ring buffer for throughput"
+ *  https://rigtorp.se/ringbuffer/
+ */
+
+/// STD
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+/// ECSL
+#include <ecsl/containers/detail/Concurrency.hpp>
+
+namespace ecsl {
+namespace containers {
+
+/**
+ * @brief Contiguous range of ring slots
+ */
+template<class T>
+class ring_span
+{
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+    using pointer       = T*;
+    using reference     = T&;
+    using iterator      = T*;
+
+  private:
+    pointer m_data;
+    size_type m_size;
+
+  public:
+    constexpr ring_span() noexcept : m_data{nullptr}, m_size{0} {}
+    constexpr ring_span(pointer data, size_type size) noexcept : m_data{data}, m_size{size} {}
+
+    constexpr pointer data() const noexcept { return m_data; }
+    constexpr size_type size() const noexcept { return m_size; }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+    constexpr reference operator[](size_type position) const noexcept { return m_data[position]; }
+    constexpr iterator begin() const noexcept { return m_data; }
+    constexpr iterator end() const noexcept { return m_data + m_size; }
+};
+
+/**
+ * @brief Bounded wait-free queue for exactly one producer and one consumer
+ * thread. Producer side: try_push, try_emplace, push_n, reserve, commit.
+ * Consumer side: try_pop, front, pop, pop_n, peek, consume.
+ */
+template<class T>
+class spsc_ring
+{
+    static_assert(std::is_nothrow_destructible<T>::value,
+        "spsc_ring requires nothrow destructible elements");
+
+    static constexpr std::size_t CACHE_LINE_SIZE = detail::concurrency::CACHE_LINE_SIZE;
+
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+    using pointer       = T*;
+
+  private:
+    //? Read only after construction
+    alignas(CACHE_LINE_SIZE) pointer m_slots;
+    size_type m_mask;
+    //? Producer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_type> m_tail;
+    size_type m_head_cached;
+    //? Consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_type> m_head;
+    size_type m_tail_cached;
+
+    static size_type capacity_for_(size_type capacity)
+    {
+        if (capacity == 0 || capacity > (~size_type{0} >> 1) / sizeof(T))
+        {
+            throw std::length_error{"spsc_ring length error"};
+        }
+        size_type r_{1};
+        while (r_ < capacity)
+        {
+            r_ <<= 1;
+        }
+        return r_;
+    }
+
+    inline pointer slot_(size_type index) const noexcept
+    {
+        return m_slots + (index & m_mask);
+    }
+
+    /**
+     * Free slots for the producer, the shared head is read only if cached
+     * value gives less than count
+     */
+    inline size_type free_(size_type tail, size_type count) noexcept
+    {
+        auto free_count_ = capacity() - (tail - m_head_cached);
+        if (free_count_ < count)
+        {
+            m_head_cached = m_head.load(std::memory_order_acquire);
+            free_count_ = capacity() - (tail - m_head_cached);
+        }
+        return free_count_;
+    }
+
+    /**
+     * Ready elements for the consumer
+     */
+    inline size_type ready_(size_type head, size_type count) noexcept
+    {
+        auto ready_count_ = m_tail_cached - head;
+        if (ready_count_ < count)
+        {
+            m_tail_cached = m_tail.load(std::memory_order_acquire);
+            ready_count_ = m_tail_cached - head;
+        }
+        return ready_count_;
+    }
+
+  public:
+    /**
+     * @brief Ring of at least capacity slots (rounded up to a power of two)
+     */
+    explicit spsc_ring(size_type capacity) :
+        m_slots{nullptr}, m_mask{capacity_for_(capacity) - 1},
+        m_tail{0}, m_head_cached{0}, m_head{0}, m_tail_cached{0}
+    {   //? The class alignment pads the consumer line up to the next object
+        m_slots = std::allocator<T>{}.allocate(m_mask + 1);
+    }
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    ~spsc_ring()
+    {
+        const auto tail_ = m_tail.load(std::memory_order_relaxed);
+        for (auto i = m_head.load(std::memory_order_relaxed); i != tail_; ++i)
+        {
+            slot_(i)->~T();
+        }
+        std::allocator<T>{}.deallocate(m_slots, capacity());
+    }
+
+    inline size_type capacity() const noexcept { return m_mask + 1; }
+
+    /**
+     * @brief Count of elements, exact only when called from producer or
+     * consumer with the other side idle
+     */
+    inline size_type size() const noexcept
+    {
+        const auto head_ = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head_;
+    }
+
+    inline bool empty() const noexcept { return size() == 0; }
+
+    /* Producer */
+
+    template<class ... Args>
+    bool try_emplace(Args&& ... args)
+        noexcept(std::is_nothrow_constructible<T, Args...>::value)
+    {
+        const auto tail_ = m_tail.load(std::memory_order_relaxed);
+        if (!free_(tail_, 1))
+        {
+            return false;
+        }
+        ::new(static_cast<void*>(slot_(tail_))) T(std::forward<Args>(args)...);
+        m_tail.store(tail_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    inline bool try_push(const T& value) noexcept(std::is_nothrow_copy_constructible<T>::value)
+    {
+        return try_emplace(value);
+    }
+
+    inline bool try_push(T&& value) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        return try_emplace(std::move(value));
+    }
+
+    /**
+     * @brief Copies up to count elements of src into the ring
+     * If a copy throws, the copies made so far are destroyed and nothing
+     * is pushed.
+     * @return Count of pushed elements
+     */
+    size_type push_n(const T* src, size_type count)
+        noexcept(std::is_nothrow_copy_constructible<T>::value)
+    {
+        const auto tail_ = m_tail.load(std::memory_order_relaxed);
+        const auto free_count_ = free_(tail_, count);
+        const auto pushed_ = count < free_count_ ? count : free_count_;
+        size_type i{0};
+        try
+        {
+            for (; i < pushed_; ++i)
+            {
+                ::new(static_cast<void*>(slot_(tail_ + i))) T(src[i]);
+            }
+        }
+        catch (...)
+        {   //? Unpublished slots are constructed over by later pushes
+            while (i-- > 0)
+            {
+                slot_(tail_ + i)->~T();
+            }
+            throw;
+        }
+        m_tail.store(tail_ + pushed_, std::memory_order_release);
+        return pushed_;
+    }
+
+    /**
+     * @brief Uninitialized contiguous slots for at most count elements
+     * The range may be shorter than count when the ring is almost full or
+     * the free space wraps around. The elements must be constructed in the
+     * slots before commit().
+     */
+    ring_span<T> reserve(size_type count) noexcept
+    {
+        const auto tail_ = m_tail.load(std::memory_order_relaxed);
+        const auto free_count_ = free_(tail_, count);
+        const auto contiguous_ = capacity() - (tail_ & m_mask);
+        auto size_ = count < free_count_ ? count : free_count_;
+        size_ = size_ < contiguous_ ? size_ : contiguous_;
+        return {slot_(tail_), size_};
+    }
+
+    /**
+     * @brief Publishes count elements constructed in reserved slots
+     */
+    inline void commit(size_type count) noexcept
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /* Consumer */
+
+    /**
+     * @brief Oldest element or nullptr if the ring is empty
+     */
+    inline pointer front() noexcept
+    {
+        const auto head_ = m_head.load(std::memory_order_relaxed);
+        return ready_(head_, 1) ? slot_(head_) : nullptr;
+    }
+
+    /**
+     * @brief Removes the oldest element, the ring must not be empty
+     */
+    inline void pop() noexcept
+    {
+        const auto head_ = m_head.load(std::memory_order_relaxed);
+        slot_(head_)->~T();
+        m_head.store(head_ + 1, std::memory_order_release);
+    }
+
+    bool try_pop(T& value) noexcept(std::is_nothrow_move_assignable<T>::value)
+    {
+        const auto head_ = m_head.load(std::memory_order_relaxed);
+        if (!ready_(head_, 1))
+        {
+            return false;
+        }
+        auto* slot_ptr_ = slot_(head_);
+        value = std::move(*slot_ptr_);
+        slot_ptr_->~T();
+        m_head.store(head_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Moves up to count oldest elements to dst
+     * If a move throws, the elements moved so far are popped and the
+     * failed one stays the oldest.
+     * @return Count of popped elements
+     */
+    size_type pop_n(T* dst, size_type count) noexcept(std::is_nothrow_move_assignable<T>::value)
+    {
+        const auto head_ = m_head.load(std::memory_order_relaxed);
+        const auto ready_count_ = ready_(head_, count);
+        const auto popped_ = count < ready_count_ ? count : ready_count_;
+        size_type i{0};
+        try
+        {
+            for (; i < popped_; ++i)
+            {
+                auto* slot_ptr_ = slot_(head_ + i);
+                dst[i] = std::move(*slot_ptr_);
+                slot_ptr_->~T();
+            }
+        }
+        catch (...)
+        {   //? Release the destroyed slots, the failed one stays in the ring
+            m_head.store(head_ + i, std::memory_order_release);
+            throw;
+        }
+        m_head.store(head_ + popped_, std::memory_order_release);
+        return popped_;
+    }
+
+    /**
+     * @brief Contiguous range of at most count oldest elements
+     * The range may be shorter than count when the elements wrap around.
+     */
+    ring_span<T> peek(size_type count) noexcept
+    {
+        const auto head_ = m_head.load(std::memory_order_relaxed);
+        const auto ready_count_ = ready_(head_, count);
+        const auto contiguous_ = capacity() - (head_ & m_mask);
+        auto size_ = count < ready_count_ ? count : ready_count_;
+        size_ = size_ < contiguous_ ? size_ : contiguous_;
+        return {slot_(head_), size_};
+    }
+
+    /**
+     * @brief Destroys count oldest (peeked) elements and frees their slots
+     */
+    void consume(size_type count) noexcept
+    {
+        const auto head_ = m_head.load(std::memory_order_relaxed);
+        if constexpr (!std::is_trivially_destructible<T>::value)
+        {
+            for (size_type i{0}; i < count; ++i)
+            {
+                slot_(head_ + i)->~T();
+            }
+        }
+        m_head.store(head_ + count, std::memory_order_release);
+    }
+};
+
+} // namespace containers
+
+template<class T>
+using spsc_ring_t = containers::spsc_ring<T>;
+
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_SPSC_RING_HPP_ */
@@ -0,0 +1,82 @@
+#ifndef ECSL_CONTAINERS_DETAIL_CONCURRENCY_HPP_
+#define ECSL_CONTAINERS_DETAIL_CONCURRENCY_HPP_
+
+/**
+ * @file Concurrency.hpp
+ * Helpers shared by the concurrent queues
+ */
+
+/// STD
+#include <cstddef>
+#include <thread>
+/// ECSL
+#include <ecsl/platform/Compiler.hpp>
+#include <ecsl/platform/Simd.hpp>
+
+namespace ecsl {
+namespace containers {
+namespace detail {
+namespace concurrency {
+
+/**
+ * Distance between data written by different threads
+ * x86 prefetches cache lines in 128 byte pairs and Apple aarch64 cores
+ * have 128 byte lines, so 64 bytes apart is not enough there
+ */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64)
+constexpr std::size_t CACHE_LINE_SIZE = 128;
+#else
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+#endif
+
+/**
+ * Hint for the core that the thread is spinning
+ */
+inline void cpu_relax() noexcept
+{
+#if defined(ECSL_SIMD_SSE2)
+    _mm_pause();
+#elif defined(ECSL_SIMD_ARM) && defined(ECSL_COMPILER_MSVC)
+    __yield();
+#elif defined(ECSL_SIMD_ARM)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * Exponential backoff of a thread waiting for other threads: spins 2^step
+ * times up to 2^SPIN_STEPS, then yields the time slice
+ */
+class backoff
+{
+    static constexpr unsigned SPIN_STEPS = 6;
+
+    unsigned m_step;
+
+  public:
+    backoff() noexcept : m_step{0} {}
+
+    void operator()() noexcept
+    {
+        if (m_step <= SPIN_STEPS)
+        {
+            for (unsigned i{0}; i < (1u << m_step); ++i)
+            {
+                cpu_relax();
+            }
+            ++m_step;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    inline void reset() noexcept { m_step = 0; }
+};
+
+} // namespace concurrency
+} // namespace detail
+} // namespace containers
+} // namespace ecsl
+#endif /* ECSL_CONTAINERS_DETAIL_CONCURRENCY_HPP_ */
@@ -7,6 +7,15 @@
 
 namespace ecsl {
 namespace containers {
+
+/**
+ * @brief Defines whether T may be moved to other storage with memcpy
+ * (move construction followed by destruction of the source is a bitwise
+ * copy). May be specialized for types like std::unique_ptr.
+ */
+template<class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
 namespace detail {
 
 template<class T>
@@ -50,7 +50,7 @@ class object_pool
         for (size_type i{0}; i < blocks_count_; ++i)
         {
             m_blocks.emplace_front();
-            consume_block(*m_blocks.begin());
+            consume_block_(*m_blocks.begin());
         }
         return true;
     }
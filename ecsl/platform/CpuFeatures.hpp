@@ -0,0 +1,126 @@
+#ifndef ECSL_PLATFORM_CPU_FEATURES_HPP_
+#define ECSL_PLATFORM_CPU_FEATURES_HPP_
+
+/**
+ * @file CpuFeatures.hpp
+ * Detects instruction set extensions supported by the running processor
+ * (and enabled by the operating system) for run time dispatch of the code
+ * compiled with ECSL_SIMD_TARGET (see Simd.hpp).
+ *
+ * Detection is done once on the first call of ecsl::runtime_cpu_features().
+ * On non-x86 targets and unknown compilers all flags are false.
+ *
+ * Sources:
+ *  https://gcc.gnu.org/onlinedocs/gcc/x86-Built-in-Functions.html
+ *  https://docs.microsoft.com/en-us/cpp/intrinsics/cpuid-cpuidex
+ *  Intel 64 and IA-32 Architectures Software Developer's Manual, CPUID
+ */
+
+/// ECSL
+#include <ecsl/platform/Compiler.hpp>
+#include <ecsl/platform/Simd.hpp>
+
+namespace ecsl {
+
+/**
+ * @brief Set of x86 extensions available at run time
+ */
+struct cpu_features
+{
+    bool sse4_2;
+    bool popcnt;
+    bool avx;
+    bool avx2;
+    bool bmi1;
+    bool bmi2;
+    bool f16c;
+    bool avx512f;
+    bool avx512bw;
+    bool avx512vl;
+    bool avx512vpopcntdq;
+};
+
+namespace detail {
+namespace cpuid {
+
+#if defined(ECSL_SIMD_X86) && (defined(ECSL_COMPILER_GCC) || defined(ECSL_COMPILER_CLANG))
+
+inline cpu_features detect() noexcept
+{
+    //? May be called from static initialization before libgcc one
+    __builtin_cpu_init();
+    cpu_features r_{};
+    r_.sse4_2 = __builtin_cpu_supports("sse4.2");
+    r_.popcnt = __builtin_cpu_supports("popcnt");
+    r_.avx = __builtin_cpu_supports("avx");
+    r_.avx2 = __builtin_cpu_supports("avx2");
+    r_.bmi1 = __builtin_cpu_supports("bmi");
+    r_.bmi2 = __builtin_cpu_supports("bmi2");
+    r_.f16c = __builtin_cpu_supports("f16c");
+    r_.avx512f = __builtin_cpu_supports("avx512f");
+    r_.avx512bw = __builtin_cpu_supports("avx512bw");
+    r_.avx512vl = __builtin_cpu_supports("avx512vl");
+    r_.avx512vpopcntdq = __builtin_cpu_supports("avx512vpopcntdq");
+    return r_;
+}
+
+#elif defined(ECSL_SIMD_X86) && defined(ECSL_COMPILER_MSVC)
+
+inline cpu_features detect() noexcept
+{
+    cpu_features r_{};
+    int info_[4];
+    __cpuid(info_, 0);
+    const int max_ = info_[0];
+    __cpuid(info_, 1);
+    const int ecx1_ = info_[2];
+    int ebx7_{0}, ecx7_{0};
+    if (max_ >= 7)
+    {
+        __cpuidex(info_, 7, 0);
+        ebx7_ = info_[1];
+        ecx7_ = info_[2];
+    }
+    //? AVX state must be enabled by OS: XMM and YMM (and ZMM for AVX-512)
+    const bool osxsave_ = ecx1_ & (1 << 27);
+    const unsigned long long xcr0_ = osxsave_ ? _xgetbv(0) : 0;
+    const bool ymm_ = (xcr0_ & 0x06) == 0x06;
+    const bool zmm_ = (xcr0_ & 0xE6) == 0xE6;
+
+    r_.sse4_2 = ecx1_ & (1 << 20);
+    r_.popcnt = ecx1_ & (1 << 23);
+    r_.avx = ymm_ && (ecx1_ & (1 << 28));
+    r_.f16c = r_.avx && (ecx1_ & (1 << 29));
+    r_.avx2 = r_.avx && (ebx7_ & (1 << 5));
+    r_.bmi1 = ebx7_ & (1 << 3);
+    r_.bmi2 = ebx7_ & (1 << 8);
+    r_.avx512f = zmm_ && (ebx7_ & (1 << 16));
+    r_.avx512bw = r_.avx512f && (ebx7_ & (1 << 30));
+    r_.avx512vl = r_.avx512f && (ebx7_ & (1 << 31));
+    r_.avx512vpopcntdq = r_.avx512f && (ecx7_ & (1 << 14));
+    return r_;
+}
+
+#else
+
+inline cpu_features detect() noexcept
+{
+    return cpu_features{};
+}
+
+#endif
+
+} // namespace cpuid
+} // namespace detail
+
+/**
+ * @brief Extensions of the running processor (detected once)
+ */
+inline const cpu_features& runtime_cpu_features() noexcept
+{
+    static const cpu_features features_ = detail::cpuid::detect();
+    return features_;
+}
+
+} // namespace ecsl
+#endif /* ECSL_PLATFORM_CPU_FEATURES_HPP_ */
@@ -0,0 +1,119 @@
+#ifndef ECSL_PLATFORM_SIMD_HPP_
+#define ECSL_PLATFORM_SIMD_HPP_
+
+/**
+ * @file Simd.hpp
+ * Detects SIMD instruction set extensions enabled for current translation
+ * unit and includes the corresponding intrinsics headers
+ *
+ * Detection is done at compile time from the compiler predefined macros
+ * (a.e. -msse4.2, -mavx2 or -march=native for gcc/clang/icc and
+ * /arch:AVX2 for msvc), so the code paths guarded by this macro are chosen
+ * by the build flags of the including translation unit.
+ *
+ * For each detected extension the ECSL_SIMD_* macro is defined:
+ *  ECSL_SIMD_SSE2, ECSL_SIMD_SSSE3, ECSL_SIMD_SSE4_1, ECSL_SIMD_SSE4_2,
+ *  ECSL_SIMD_POPCNT, ECSL_SIMD_AVX, ECSL_SIMD_AVX2, ECSL_SIMD_BMI1,
+ *  ECSL_SIMD_BMI2, ECSL_SIMD_F16C, ECSL_SIMD_AVX512F, ECSL_SIMD_AVX512BW,
+ *  ECSL_SIMD_AVX512VL, ECSL_SIMD_AVX512VPOPCNTDQ, ECSL_SIMD_NEON
+ *
+ * Also ECSL_SIMD_X86 or ECSL_SIMD_ARM is defined for the target architecture.
+ *
+ * For run time dispatch ECSL_SIMD_DISPATCH is defined when functions may be
+ * compiled for an extension not enabled for the translation unit with
+ * ECSL_SIMD_TARGET("avx2"), ECSL_SIMD_TARGET("avx512f,avx512bw") etc.
+ * Such functions must be called only after the check of
+ * ecsl::runtime_cpu_features() (see CpuFeatures.hpp).
+ *
+ * Sources:
+ *  https://gcc.gnu.org/onlinedocs/gcc/x86-Options.html
+ *  https://docs.microsoft.com/en-us/cpp/build/reference/arch-x64
+ *  https://developer.arm.com/architectures/instruction-sets/intrinsics/
+ */
+
+/// ECSL
+#include <ecsl/platform/Compiler.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   define ECSL_SIMD_X86
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__arm__) || defined(_M_ARM)
+#   define ECSL_SIMD_ARM
+#endif
+
+#if defined(ECSL_SIMD_X86)
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ECSL_SIMD_SSE2
+#endif
+//? msvc does not report SSSE3-SSE4.2 separately: they are implied by /arch:AVX
+#if defined(__SSSE3__) || (defined(ECSL_COMPILER_MSVC) && defined(__AVX__))
+#   define ECSL_SIMD_SSSE3
+#endif
+#if defined(__SSE4_1__) || (defined(ECSL_COMPILER_MSVC) && defined(__AVX__))
+#   define ECSL_SIMD_SSE4_1
+#endif
+#if defined(__SSE4_2__) || (defined(ECSL_COMPILER_MSVC) && defined(__AVX__))
+#   define ECSL_SIMD_SSE4_2
+#endif
+#if defined(__POPCNT__) || (defined(ECSL_COMPILER_MSVC) && defined(__AVX__))
+#   define ECSL_SIMD_POPCNT
+#endif
+#if defined(__AVX__)
+#   define ECSL_SIMD_AVX
+#endif
+#if defined(__AVX2__)
+#   define ECSL_SIMD_AVX2
+#endif
+#if defined(__BMI__) || (defined(ECSL_COMPILER_MSVC) && defined(__AVX2__))
+#   define ECSL_SIMD_BMI1
+#endif
+#if defined(__BMI2__) || (defined(ECSL_COMPILER_MSVC) && defined(__AVX2__))
+#   define ECSL_SIMD_BMI2
+#endif
+#if defined(__F16C__) || (defined(ECSL_COMPILER_MSVC) && defined(__AVX2__))
+#   define ECSL_SIMD_F16C
+#endif
+#if defined(__AVX512F__)
+#   define ECSL_SIMD_AVX512F
+#endif
+#if defined(__AVX512BW__)
+#   define ECSL_SIMD_AVX512BW
+#endif
+#if defined(__AVX512VL__)
+#   define ECSL_SIMD_AVX512VL
+#endif
+#if defined(__AVX512VPOPCNTDQ__)
+#   define ECSL_SIMD_AVX512VPOPCNTDQ
+#endif
+
+#if defined(ECSL_COMPILER_MSVC)
+#   include <intrin.h>
+#elif defined(ECSL_SIMD_SSE2)
+#   include <immintrin.h>
+#endif
+
+#if defined(ECSL_COMPILER_GCC) || defined(ECSL_COMPILER_CLANG)
+#   define ECSL_SIMD_DISPATCH
+#   define ECSL_SIMD_TARGET(features) __attribute__((target(features)))
+#elif defined(ECSL_COMPILER_MSVC)
+//? msvc allows any intrinsics regardless of /arch
+#   define ECSL_SIMD_DISPATCH
+#   define ECSL_SIMD_TARGET(features)
+#endif
+
+#endif /* ECSL_SIMD_X86 */
+
+#if defined(ECSL_SIMD_ARM)
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#   define ECSL_SIMD_NEON
+#   if defined(ECSL_COMPILER_MSVC) && defined(_M_ARM64)
+#       include <arm64_neon.h>
+#   else
+#       include <arm_neon.h>
+#   endif
+#endif
+
+#endif /* ECSL_SIMD_ARM */
+
+#endif /* ECSL_PLATFORM_SIMD_HPP_ */
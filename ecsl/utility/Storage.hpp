@@ -87,7 +87,7 @@ class storage
 
     template<class U>
     inline typename std::enable_if<
-        std::is_assignable<value_type, U>::value
+        std::is_assignable<value_type, U>::value,
         reference
     >::type assign(U&& arg)
         noexcept(std::is_nothrow_assignable<value_type, U>::value)
@@ -152,7 +152,7 @@ class storage<T, storage_policy::SAFE>
 
     template<class U>
     inline typename std::enable_if<
-        std::is_assignable<value_type, U>::value
+        std::is_assignable<value_type, U>::value,
         reference
     >::type assign(U&& arg)
         noexcept(std::is_nothrow_assignable<value_type, U>::value)
@@ -237,7 +237,7 @@ class storage<T, storage_policy::SAFE_THROWING>
 
     template<class U>
     inline typename std::enable_if<
-        std::is_assignable<value_type, U>::value
+        std::is_assignable<value_type, U>::value,
         reference
     >::type assign(U&& arg)
     {